@@ -42,6 +42,33 @@ typedef struct NasrTile
     unsigned char animation;
 } NasrTile;
 
+#define NASR_MAX_TILE_ANIMATIONS       254
+#define NASR_MAX_TILE_ANIMATION_FRAMES 16
+
+typedef struct NasrTileAnimationFrame
+{
+    unsigned char x;
+    unsigned char y;
+} NasrTileAnimationFrame;
+
+typedef struct NasrTileAnimation
+{
+    unsigned int count;
+    unsigned int speed;
+    NasrTileAnimationFrame frames[ NASR_MAX_TILE_ANIMATION_FRAMES ];
+} NasrTileAnimation;
+
+typedef void ( * NasrTextureLoadCallback )( int texture, int success );
+
+typedef struct NasrTileHit
+{
+    int x;
+    int y;
+    float distance;
+    int normalx;
+    int normaly;
+} NasrTileHit;
+
 #define NASR_ALIGN_DEFAULT   0
 #define NASR_ALIGN_LEFT      1
 #define NASR_ALIGN_RIGHT     2
@@ -82,11 +109,17 @@ typedef struct NasrText
 #define NASR_SAMPLING_DEFAULT 0
 #define NASR_SAMPLING_NEAREST 1
 #define NASR_SAMPLING_LINEAR  2
+#define NASR_SAMPLING_MIPMAP  3
 
 #define NASR_INDEXED_DEFAULT 0
 #define NASR_INDEXED_NO      1
 #define NASR_INDEXED_YES     2
 
+#define NASR_CHARSET_BITMAP 0
+#define NASR_CHARSET_SDF    1
+
+#define NASR_MAX_TILEMAP_LAYERS 8
+
 typedef void ( * input_handle_t )( void *, int, int, int, int );
 
 // Init, Close, Update
@@ -124,7 +157,9 @@ void NasrSetGlobalPalette( uint_fast8_t palette );
 
 // Charset
 int NasrAddCharset( const char * texture, const char * chardata );
+int NasrAddCharsetEx( const char * texture, const char * chardata, int type );
 void NasrRemoveCharset( unsigned int charset );
+int NasrPackCharsets( void );
 
 // Time
 double NasrGetTime( void );
@@ -236,6 +271,52 @@ int NasrGraphicsAddTilemap
     float tilingx,
     float tilingy
 );
+int NasrGraphicsAddTilemapEx
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    unsigned int texture,
+    const NasrTile * tiles,
+    unsigned int w,
+    unsigned int h,
+    int_fast8_t useglobalpal,
+    float opacity,
+    float tilingx,
+    float tilingy,
+    unsigned int tilew,
+    unsigned int tileh
+);
+int NasrGraphicsAddChunkedTilemap
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    unsigned int texture,
+    const NasrTile * tiles,
+    unsigned int w,
+    unsigned int h,
+    int_fast8_t useglobalpal,
+    float opacity
+);
+int NasrGraphicsAddLayeredTilemap
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    unsigned int texture,
+    const NasrTile * const * tiles,
+    unsigned int layer_count,
+    unsigned int w,
+    unsigned int h,
+    unsigned int tilew,
+    unsigned int tileh,
+    int_fast8_t useglobalpal,
+    float opacity
+);
 int NasrGraphicsAddText
 (
     float scrollx,
@@ -280,6 +361,26 @@ int NasrGraphicsAddTextGradientPalette
     uint_fast8_t color1,
     uint_fast8_t color2
 );
+int NasrGraphicsAddTextStream
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    NasrColor color
+);
+int NasrGraphicsAddTextStreamPalette
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    uint_fast8_t palette,
+    uint_fast8_t useglobalpal,
+    uint_fast8_t color
+);
 int NasrGraphicsAddCounter
 (
     float scrollx,
@@ -525,8 +626,27 @@ void NasrGraphicsTilemapSetTilePalette( unsigned int id, unsigned int x, unsigne
 void NasrGraphicsTilemapSetTileAnimation( unsigned int id, unsigned int x, unsigned int y, unsigned char v );
 void NasrGraphicsTilemapSetTile( unsigned int id, unsigned int x, unsigned int y, NasrTile tile );
 void NasrGraphicsTilemapClearTile( unsigned int id, unsigned int x, unsigned int y );
+void NasrGraphicsTilemapSetTiles( unsigned int id, NasrRectInt region, const NasrTile * tiles, unsigned int stride );
+void NasrGraphicsTilemapFill( unsigned int id, NasrRectInt region, NasrTile tile );
+NasrTile NasrGraphicsTilemapGetTile( unsigned int id, int x, int y );
+int NasrGraphicsTilemapRaycast( unsigned int id, float x, float y, float dx, float dy, float maxdist, NasrTileHit * hit );
+unsigned int NasrGraphicsTilemapOverlapRect( unsigned int id, NasrRect rect );
 float NasrGraphicsTilemapGetOpacity( unsigned int id );
 void NasrGraphicsTilemapSetOpacity( unsigned int id, float opacity );
+void NasrGraphicsTilemapSetBaked( unsigned int id, int_fast8_t baked );
+
+// ChunkedTilemapGraphics Manipulation
+void NasrGraphicsChunkedTilemapSetX( unsigned int id, float v );
+void NasrGraphicsChunkedTilemapSetY( unsigned int id, float v );
+void NasrGraphicsChunkedTilemapSetTile( unsigned int id, unsigned int x, unsigned int y, NasrTile tile );
+void NasrGraphicsChunkedTilemapSetChunk( unsigned int id, unsigned int cx, unsigned int cy, const NasrTile * tiles );
+
+// LayeredTilemapGraphics Manipulation
+void NasrGraphicsLayeredTilemapSetX( unsigned int id, float v );
+void NasrGraphicsLayeredTilemapSetY( unsigned int id, float v );
+void NasrGraphicsLayeredTilemapSetLayerScroll( unsigned int id, unsigned int layer, float scrollx, float scrolly );
+void NasrGraphicsLayeredTilemapSetLayerOpacity( unsigned int id, unsigned int layer, float opacity );
+void NasrGraphicsLayeredTilemapSetTile( unsigned int id, unsigned int layer, unsigned int x, unsigned int y, NasrTile tile );
 
 // TextGraphics Manipulation
 float NasrGraphicsTextGetXOffset( unsigned int id );
@@ -537,8 +657,19 @@ void NasrGraphicsTextSetYOffset( unsigned int id, float v );
 void NasrGraphicsTextAddToYOffset( unsigned int id, float v );
 void NasrGraphicsTextSetCount( unsigned int id, int count );
 void NasrGraphicsTextIncrementCount( unsigned int id );
+float NasrGraphicsTextGetScale( unsigned int id );
+void NasrGraphicsTextSetScale( unsigned int id, float v );
 void NasrSetTextOpacity( unsigned int id, float v );
 
+// TextStreamGraphics Manipulation
+void NasrGraphicsTextStreamSetCount( unsigned int id, int count );
+void NasrGraphicsTextStreamIncrementCount( unsigned int id );
+float NasrGraphicsTextStreamGetScroll( unsigned int id );
+void NasrGraphicsTextStreamSetScroll( unsigned int id, float v );
+void NasrGraphicsTextStreamAddToScroll( unsigned int id, float v );
+float NasrGraphicsTextStreamGetHeight( unsigned int id );
+void NasrGraphicsTextStreamSetBudget( unsigned int id, unsigned int glyphs );
+
 // CounterGraphics Manipulation
 void NasrGraphicsCounterSetNumber( unsigned int id, float n );
 void NasrGraphicsCounterSetOpacity( unsigned int id, float v );
@@ -548,15 +679,26 @@ void NasrGraphicsCounterSetYOffset( unsigned id, float v );
 // Texture
 int NasrLoadFileAsTexture( const char * filename );
 int NasrLoadFileAsTextureEx( const char * filename, int sampling, int indexed );
+int NasrBakeTextureFile( const char * src, const char * dest, int indexed );
+int NasrLoadFileAsArrayTexture( const char * filename, int sampling, int indexed );
+int NasrLoadFileAsAtlasTexture( const char * filename, int sampling, int indexed );
+int NasrLoadFileAsTextureAsync( const char * filename, int sampling, int indexed, NasrTextureLoadCallback callback );
+void NasrSetTextureUploadBudget( unsigned int bytes );
+void NasrSetTextureMemoryBudget( uint64_t bytes );
+uint64_t NasrGetTextureMemoryUsage( void );
 int NasrAddTexture( unsigned char * data, unsigned int width, unsigned int height );
 int NasrAddTextureEx( unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed );
+int NasrAddArrayTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed );
+int NasrAddAtlasTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed );
 int NasrAddTextureBlank( unsigned int width, unsigned int height );
 int NasrAddTextureBlankEx( unsigned int width, unsigned int height, int sampling, int indexed );
+int NasrSetTilesetAnimations( unsigned int texture, const NasrTileAnimation * animations, unsigned int count );
 void NasrGetTexturePixels( unsigned int texture, void * pixels );
 void NasrCopyTextureToTexture( unsigned int src, unsigned int dest, NasrRectInt srccoords, NasrRectInt destcoords );
 void NasrApplyTextureToPixelData( unsigned int texture, unsigned char * dest, NasrRectInt srccoords, NasrRectInt destcoords );
 void NasrCopyPixelData( unsigned char * src, unsigned char * dest, NasrRectInt srccoords, NasrRectInt destcoords, int maxsrcw, int maxsrch );
 void NasrTileTexture( unsigned int texture, unsigned char * pixels, NasrRectInt srccoords, NasrRectInt destcoords );
+void NasrTileTextureToTexture( unsigned int src, unsigned int dest, NasrRectInt srccoords, NasrRectInt destcoords );
 void NasrSetTextureAsTarget( unsigned int texture );
 void NasrReleaseTextureTarget( void );
 void NasrClearTextures( void );
@@ -5,7 +5,11 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+
 char * NasrReadFile( const char * filename );
+void * NasrMapFile( const char * filename, size_t * size );
+void NasrUnmapFile( void * data, size_t size );
 
 #ifdef __cplusplus
 }
@@ -7,6 +7,8 @@
 #include "nasr_io.h"
 #include "nasr_log.h"
 #include "nasr_math.h"
+#include <float.h>
+#include <pthread.h>
 #include <stdio.h>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -53,11 +55,57 @@ typedef struct NasrShader
 #define NASR_GRAPHIC_TILEMAP       5
 #define NASR_GRAPHIC_TEXT          6
 #define NASR_GRAPHIC_COUNTER       7
+#define NASR_GRAPHIC_TEXT_STREAM   8
+#define NASR_GRAPHIC_TILEMAP_CHUNKED 9
+#define NASR_GRAPHIC_TILEMAP_LAYERED 10
 
 #define NASR_PALETTE_NONE    0
 #define NASR_PALETTE_SET     1
 #define NASR_PALETTE_DEFAULT 2
 
+#define MAX_COUNTER_DIGITS 32
+#define COUNTER_POINT      10
+#define COUNTER_BLANK      11
+#define COUNTER_TABLE_SIZE 12
+
+#define TEXT_STREAM_DEFAULT_BUDGET 256
+
+#define MAX_TILEMAP_DIRTY_RECTS 4
+
+#define TILEMAP_CHUNK_SIZE 64
+#define TILEMAP_CHUNK_PIXELS ( TILEMAP_CHUNK_SIZE * 16.0f )
+
+#define TILEMAP_BAKE_SIZE 256
+
+#define TEXTURE_LOAD_THREADS 4
+#define TEXTURE_UPLOAD_DEFAULT_BUDGET ( 4 * 1024 * 1024 )
+
+#define TEXTURE_FILE_MAGIC "NTEX"
+#define TEXTURE_FILE_VERSION 1
+#define TEXTURE_FILE_FORMAT_R8 0
+#define TEXTURE_FILE_FORMAT_RGBA8 1
+#define TEXTURE_FILE_MAX_LEVELS 32
+
+#define MAX_TEXTURE_ANISOTROPY 8.0f
+
+// Not in core 3.3, but near every driver has it; values are same for EXT & ARB versions.
+#ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#endif
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#endif
+
+#define TEXTURE_MAP_MIN_SIZE 16
+#define TEXTURE_NAMES_MIN_SIZE 1024
+
+#define MAX_TEXTURE_ARRAYS 32
+#define TEXTURE_ARRAY_START_LAYERS 4
+
+#define ATLAS_PAGE_SIZE 2048
+#define ATLAS_PADDING 1
+#define MAX_ATLAS_PAGES 16
+
 typedef struct NasrGraphicRect
 {
     NasrRect rect;
@@ -114,8 +162,67 @@ typedef struct NasrGraphicTilemap
     float opacity;
     float tilingx;
     float tilingy;
+    unsigned int tilew;
+    unsigned int tileh;
+    unsigned int program;
+    uint64_t * solid;
+    unsigned int * solid_rows;
+    unsigned int solid_stride;
+    NasrRectInt dirty[ MAX_TILEMAP_DIRTY_RECTS ];
+    uint_fast8_t dirty_count;
+    uint_fast8_t bake;
+    uint_fast8_t bake_check;
+    uint_fast8_t bake_ok;
+    unsigned int bake_palette;
+    unsigned int bake_texture_version;
+    unsigned int bake_chunksw;
+    unsigned int bake_chunksh;
+    GLuint * bake_textures;
+    uint_fast8_t * bake_stale;
 } NasrGraphicTilemap;
 
+typedef struct NasrGraphicChunkedTilemap
+{
+    unsigned int texture;
+    unsigned int w;
+    unsigned int h;
+    unsigned int chunksw;
+    unsigned int chunksh;
+    unsigned char ** chunks;
+    int * chunk_slots;
+    unsigned int slot_count;
+    GLuint * slot_textures;
+    int * slot_chunks;
+    unsigned int * slot_used;
+    uint_fast8_t * slot_dirty;
+    unsigned int frame;
+    float x;
+    float y;
+    int_fast8_t useglobalpal;
+    float opacity;
+} NasrGraphicChunkedTilemap;
+
+typedef struct NasrGraphicLayeredTilemap
+{
+    unsigned int texture;
+    GLuint maps;
+    unsigned int w;
+    unsigned int h;
+    unsigned int layer_count;
+    unsigned int tilew;
+    unsigned int tileh;
+    unsigned int program;
+    unsigned char * data;
+    float x;
+    float y;
+    float scrollx[ NASR_MAX_TILEMAP_LAYERS ];
+    float scrolly[ NASR_MAX_TILEMAP_LAYERS ];
+    float opacity[ NASR_MAX_TILEMAP_LAYERS ];
+    NasrRectInt dirty[ NASR_MAX_TILEMAP_LAYERS ];
+    uint_fast8_t dirty_layers;
+    int_fast8_t useglobalpal;
+} NasrGraphicLayeredTilemap;
+
 typedef struct NasrGraphicText
 {
     unsigned int capacity;
@@ -131,6 +238,9 @@ typedef struct NasrGraphicText
     float yoffset;
     float shadow;
     float opacity;
+    float scale;
+    float originx;
+    float originy;
 } NasrGraphicText;
 
 typedef struct NasrGraphicCounter
@@ -140,11 +250,11 @@ typedef struct NasrGraphicCounter
     unsigned int maxdecimals;
     uint_fast8_t numpadding;
     uint_fast8_t decimalpadding;
-    NasrChar * chars;
+    GLint digits[ MAX_COUNTER_DIGITS ];
     float maxnum;
-    float * vertices;
-    unsigned int * vaos;
-    unsigned int * vbos;
+    float vertices[ VERTEX_RECT_SIZE ];
+    unsigned int vao;
+    unsigned int vbo;
     uint_fast8_t palette;
     uint_fast8_t palette_type;
     unsigned int charset;
@@ -155,6 +265,45 @@ typedef struct NasrGraphicCounter
     NasrColor colors[ 4 ];
 } NasrGraphicCounter;
 
+typedef struct TextStreamLine
+{
+    unsigned int start;
+    unsigned int end;
+    unsigned int glyphs;
+    unsigned int first;
+    float x;
+    float y;
+    float height;
+    float letterspace;
+} TextStreamLine;
+
+typedef struct NasrGraphicTextStream
+{
+    char * string;
+    TextStreamLine * lines;
+    unsigned int line_count;
+    unsigned int glyph_count;
+    unsigned int max_line_glyphs;
+    unsigned int count;
+    unsigned int window_lines;
+    int * slot_lines;
+    float * vertices;
+    unsigned int vao;
+    unsigned int vbo;
+    unsigned int ebo;
+    unsigned int budget;
+    unsigned int charset;
+    uint_fast8_t palette;
+    uint_fast8_t palette_type;
+    NasrRect coords;
+    NasrColor color;
+    float xoffset;
+    float yoffset;
+    float scroll;
+    float shadow;
+    float opacity;
+} NasrGraphicTextStream;
+
 typedef union NasrGraphicData
 {
     NasrGraphicRect         rect;
@@ -164,6 +313,9 @@ typedef union NasrGraphicData
     NasrGraphicTilemap      tilemap;
     NasrGraphicText         text;
     NasrGraphicCounter *    counter;
+    NasrGraphicTextStream * stream;
+    NasrGraphicChunkedTilemap * chunked;
+    NasrGraphicLayeredTilemap * layered;
 } NasrGraphicData;
 
 typedef struct NasrGraphic
@@ -174,13 +326,109 @@ typedef struct NasrGraphic
     NasrGraphicData data;
 } NasrGraphic;
 
+typedef struct TileAnimationTable
+{
+    unsigned int count;
+    NasrTileAnimation * list;
+    GLuint texture;
+    unsigned char frames[ 256 * 4 ];
+} TileAnimationTable;
+
 typedef struct Texture
 {
     unsigned int width;
     unsigned int height;
     unsigned int indexed;
+    TileAnimationTable * animations;
+    uint_fast8_t loading;
+    uint_fast8_t atlas;
+    unsigned int atlas_page;
+    unsigned int atlas_x;
+    unsigned int atlas_y;
+    uint_fast8_t layered;
+    unsigned int array;
+    unsigned int layer;
+    uint64_t bytes;
+    unsigned int last_used;
+    char * filename;
+    int sampling;
+    int indexed_type;
+    uint_fast8_t evictable;
+    uint_fast8_t evicted;
+    uint_fast8_t mipmapped;
+    unsigned int version;
+    uint_fast8_t failed;
+    uint_fast8_t owned;
 } Texture;
 
+typedef struct TextureArray
+{
+    GLuint id;
+    unsigned int width;
+    unsigned int height;
+    GLint sampling;
+    GLint indexed;
+    unsigned int capacity;
+    unsigned int count;
+} TextureArray;
+
+typedef struct TextureFileHeader
+{
+    char magic[ 4 ];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t levels;
+} TextureFileHeader;
+
+typedef struct AtlasSkylineNode
+{
+    unsigned int x;
+    unsigned int y;
+    unsigned int w;
+} AtlasSkylineNode;
+
+typedef struct AtlasPage
+{
+    unsigned int texture;
+    unsigned int size;
+    GLint sampling;
+    GLint indexed;
+    unsigned int node_count;
+    AtlasSkylineNode * nodes;
+} AtlasPage;
+
+typedef struct TextureLoadJob
+{
+    char * filename;
+    unsigned int texture;
+    unsigned int generation;
+    int sampling;
+    int indexed;
+    NasrTextureLoadCallback callback;
+    unsigned char * data;
+    unsigned int width;
+    unsigned int height;
+    struct TextureLoadJob * next;
+} TextureLoadJob;
+
+typedef struct TextureLoader
+{
+    pthread_t threads[ TEXTURE_LOAD_THREADS ];
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    TextureLoadJob * queued;
+    TextureLoadJob * queued_tail;
+    TextureLoadJob * done;
+    TextureLoadJob * done_tail;
+    TextureLoadJob * waiters;
+    unsigned int thread_count;
+    unsigned int budget;
+    uint_fast8_t running;
+    uint_fast8_t quit;
+} TextureLoader;
+
 static const float vertices_base[] =
 {
     // Vertices     // Texture coords   // Color
@@ -191,9 +439,11 @@ static const float vertices_base[] =
 };
 
 #define MAX_ANIMATION_FRAME 2 * 3 * 4 * 5 * 6 * 7 * 8
-#define NUMBER_O_BASE_SHADERS 8
+#define NUMBER_O_BASE_SHADERS 14
+#define MAX_TILEMAP_PROGRAMS 8
+#define SDF_SPREAD 4.0f
 
-typedef struct TextureMapEntry { NasrHashKey key; unsigned int value; struct TextureMapEntry * next; } TextureMapEntry;
+typedef struct TextureMapEntry { hash_t hash; uint32_t distance; uint32_t key; uint32_t length; unsigned int value; } TextureMapEntry;
 
 typedef struct CharTemplate
 {
@@ -216,7 +466,13 @@ typedef struct CharMap
     CharMapEntry * list;
     unsigned int texture_id;
     Texture texture;
+    Texture image;
+    float atlasy;
+    uint_fast8_t packed;
+    uint_fast8_t type;
     CharNum nums[ 11 ];
+    float numsrc[ COUNTER_TABLE_SIZE * 4 ];
+    float numdest[ COUNTER_TABLE_SIZE * 4 ];
     float numwidth;
     float numheight;
 } CharMap;
@@ -234,6 +490,8 @@ typedef struct SpriteUniforms
     GLint texture_data;
     GLint palette_data;
     GLint tiling;
+    GLint atlas_rect;
+    GLint layer;
 } SpriteUniforms;
 
 typedef struct RectUniforms
@@ -252,11 +510,9 @@ typedef struct RectPalUniforms
 typedef struct TilemapUniforms
 {
     GLint model;
-    GLint mapw;
-    GLint maph;
-    GLint tilesetw;
-    GLint tileseth;
-    GLint animation;
+    GLint map_size;
+    GLint frames;
+    GLint animtable;
     GLint opacity;
     GLint texture;
     GLint palette;
@@ -265,6 +521,49 @@ typedef struct TilemapUniforms
     GLint tiling;
 } TilemapUniforms;
 
+typedef struct LayeredTilemapUniforms
+{
+    GLint model;
+    GLint map_size;
+    GLint view_size;
+    GLint frames;
+    GLint animtable;
+    GLint texture;
+    GLint palette;
+    GLint mapdata;
+    GLint layer_count;
+    GLint layer_offset;
+    GLint layer_opacity;
+    GLint useglobalpal;
+    GLint globalpal;
+} LayeredTilemapUniforms;
+
+typedef struct TilemapProgram
+{
+    unsigned int tilew;
+    unsigned int tileh;
+    unsigned int shader;
+    unsigned int mono_shader;
+    unsigned int layered_shader;
+    TilemapUniforms uniforms;
+    TilemapUniforms mono_uniforms;
+    LayeredTilemapUniforms layered_uniforms;
+} TilemapProgram;
+
+typedef struct CounterUniforms
+{
+    GLint texture;
+    GLint shadow;
+    GLint opacity;
+    GLint palette_id;
+    GLint palette_data;
+    GLint digits;
+    GLint digit_src;
+    GLint digit_dest;
+    GLint digit_width;
+    GLint shadow_offset;
+} CounterUniforms;
+
 typedef struct TextUniforms
 {
     GLint texture;
@@ -273,6 +572,7 @@ typedef struct TextUniforms
     GLint palette_id;
     GLint palette_data;
     GLint model;
+    GLint shadow_offset;
 } TextUniforms;
 
 // Static Data
@@ -286,51 +586,91 @@ static unsigned int current_shader = ( unsigned int )( -1 );
 static unsigned int rect_shader;
 static unsigned int sprite_shader;
 static unsigned int indexed_sprite_shader;
-static unsigned int tilemap_shader;
-static unsigned int tilemap_mono_shader;
+static unsigned int array_sprite_shader;
+static unsigned int indexed_array_sprite_shader;
 static unsigned int text_shader;
 static unsigned int text_pal_shader;
 static unsigned int rect_pal_shader;
+static unsigned int counter_shader;
+static unsigned int counter_pal_shader;
+static unsigned int text_sdf_shader;
+static unsigned int text_sdf_pal_shader;
+static unsigned int counter_sdf_shader;
+static unsigned int counter_sdf_pal_shader;
 static unsigned int * base_shaders[ NUMBER_O_BASE_SHADERS ] =
 {
     &rect_shader,
 	&sprite_shader,
 	&indexed_sprite_shader,
-	&tilemap_shader,
-	&tilemap_mono_shader,
 	&text_shader,
 	&text_pal_shader,
-    &rect_pal_shader
+    &rect_pal_shader,
+    &counter_shader,
+    &counter_pal_shader,
+    &text_sdf_shader,
+    &text_sdf_pal_shader,
+    &counter_sdf_shader,
+    &counter_sdf_pal_shader,
+    &array_sprite_shader,
+    &indexed_array_sprite_shader
 };
 static SpriteUniforms sprite_uniforms;
 static SpriteUniforms indexed_sprite_uniforms;
+static SpriteUniforms array_sprite_uniforms;
+static SpriteUniforms indexed_array_sprite_uniforms;
 static RectUniforms rect_uniforms;
 static RectPalUniforms rect_pal_uniforms;
-static TilemapUniforms tilemap_uniforms;
-static TilemapUniforms tilemap_mono_uniforms;
+static TilemapProgram tilemap_programs[ MAX_TILEMAP_PROGRAMS ];
+static unsigned int tilemap_program_count = 0;
 static TextUniforms text_uniforms;
 static TextUniforms text_pal_uniforms;
+static CounterUniforms counter_uniforms;
+static CounterUniforms counter_pal_uniforms;
+static TextUniforms text_sdf_uniforms;
+static TextUniforms text_sdf_pal_uniforms;
+static CounterUniforms counter_sdf_uniforms;
+static CounterUniforms counter_sdf_pal_uniforms;
 static NasrGraphic * graphics;
 static unsigned int max_graphics;
 static unsigned int num_o_graphics;
 static NasrRect camera = { 0.0f, 0.0f, 0.0f, 0.0f };
 static NasrRect prev_camera = { 0.0f, 0.0f, 0.0f, 0.0f };
 static NasrRect canvas = { 0.0f, 0.0f, 0.0f, 0.0f };
+static NasrRect ortho_view = { 0.0f, 0.0f, 0.0f, 0.0f };
 static int max_textures;
-static int texture_map_size;
+static uint32_t texture_map_size;
+static uint32_t texture_map_count = 0;
+static char * texture_names = 0;
+static size_t texture_names_size = 0;
+static size_t texture_names_capacity = 0;
 static unsigned int * texture_ids;
 static Texture * textures;
 static int texture_count;
+static unsigned int texture_generation = 0;
+static TextureLoader texture_loader = { .budget = TEXTURE_UPLOAD_DEFAULT_BUDGET };
+static AtlasPage atlas_pages[ MAX_ATLAS_PAGES ];
+static unsigned int atlas_page_count = 0;
+static TextureArray texture_arrays[ MAX_TEXTURE_ARRAYS ];
+static unsigned int texture_array_count = 0;
+static uint64_t texture_budget = 0;
+static uint64_t texture_bytes = 0;
+static unsigned int texture_frame = 0;
 static GLuint framebuffer;
+static GLuint bake_framebuffer;
+static GLuint copy_framebuffers[ 2 ];
 static GLint magnified_canvas_width;
 static GLint magnified_canvas_height;
 static GLint magnified_canvas_x;
 static GLint magnified_canvas_y;
 static int selected_texture = -1;
 static GLint default_sample_type = GL_LINEAR;
+static float texture_anisotropy = 0.0f;
+static GLint max_texture_size = 0;
 static TextureMapEntry * texture_map;
 static GLint default_indexed_mode = GL_RGBA;
 static unsigned int palette_texture_id;
+static unsigned int palette_version = 0;
+static unsigned int animation_frames_texture_id;
 static Texture palette_texture;
 static int max_states;
 static int max_gfx_layers;
@@ -340,9 +680,17 @@ static int * gfx_ptrs_pos_to_id;
 static int * state_for_gfx;
 static int * layer_for_gfx;
 static unsigned int animation_frame;
+static unsigned int animation_clock;
 static float animation_timer;
 static uint_fast8_t global_palette;
 static CharMapList charmaps = { 0, 0 };
+static unsigned int charset_atlas_id = 0;
+static Texture charset_atlas;
+static GLuint bound_textures[ 4 ];
+static const char * vertex_shader_code = "#version 330 core\n layout ( location = 0 ) in vec2 in_position;\n layout ( location = 1 ) in vec2 in_texture_coords;\n layout ( location = 2 ) in vec4 in_color;\n \n out vec2 texture_coords;\n out vec4 out_color;\n out vec2 out_position;\n \n uniform mat4 model;\n uniform mat4 view;\n uniform mat4 ortho;\n \n void main()\n {\n out_position = in_position;\n gl_Position = ortho * view * model * vec4( in_position, 0.0, 1.0 );\n texture_coords = in_texture_coords;\n out_color = in_color;\n }";
+static const char * tilemap_fragment_code = "out vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform usampler2D map_data;\nuniform usampler2D frame_data;\nuniform int animation_table;\nuniform vec2 map_size;\nuniform float opacity;\nuniform vec2 tiling;\n  \nvoid main()\n{\n    vec2 position = texture_coords * tiling * map_size;\n    uvec4 tile = texelFetch( map_data, ivec2( mod( floor( position ), map_size ) ), 0 );\n    if ( tile.a == 255u )\n    {\n        final_color = vec4( 0.0, 0.0, 0.0, 0.0 );\n        return;\n    }\n    if ( tile.a > 0u )\n    {\n        // Frame data holds either current frame for each frame count or, if tileset has animation table, current tile for each animation.\n        uvec4 frame = texelFetch( frame_data, ivec2( int( tile.a ), 0 ), 0 );\n        tile.xy = animation_table != 0 ? frame.xy : uvec2( tile.x + frame.r, tile.y );\n    }\n    ivec2 texel = ivec2( vec2( tile.xy ) * TILE_SIZE + floor( fract( position ) * TILE_SIZE ) );\n    float index = texelFetch( texture_data, texel, 0 ).r;\n    final_color = texture( palette_data, vec2( ( 255.0 / 256.0 ) * index, float( tile.z ) / 255.0 ) );\n    final_color.a *= opacity;\n}";
+static const char * tilemap_mono_fragment_code = "out vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform usampler2D map_data;\nuniform usampler2D frame_data;\nuniform int animation_table;\nuniform vec2 map_size;\nuniform float opacity;\nuniform uint global_palette;\nuniform vec2 tiling;\n  \nvoid main()\n{\n    vec2 position = texture_coords * tiling * map_size;\n    uvec4 tile = texelFetch( map_data, ivec2( mod( floor( position ), map_size ) ), 0 );\n    if ( tile.a == 255u )\n    {\n        final_color = vec4( 0.0, 0.0, 0.0, 0.0 );\n        return;\n    }\n    if ( tile.a > 0u )\n    {\n        // Frame data holds either current frame for each frame count or, if tileset has animation table, current tile for each animation.\n        uvec4 frame = texelFetch( frame_data, ivec2( int( tile.a ), 0 ), 0 );\n        tile.xy = animation_table != 0 ? frame.xy : uvec2( tile.x + frame.r, tile.y );\n    }\n    ivec2 texel = ivec2( vec2( tile.xy ) * TILE_SIZE + floor( fract( position ) * TILE_SIZE ) );\n    float index = texelFetch( texture_data, texel, 0 ).r;\n    final_color = texture( palette_data, vec2( ( 255.0 / 256.0 ) * index, float( global_palette ) / 256.0 ) );\n    final_color.a *= opacity;\n}";
+static const char * tilemap_layered_fragment_code = "out vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform usampler2DArray map_data;\nuniform usampler2D frame_data;\nuniform int animation_table;\nuniform vec2 map_size;\nuniform vec2 view_size;\nuniform int layer_count;\nuniform vec2 layer_offset[ MAX_LAYERS ];\nuniform float layer_opacity[ MAX_LAYERS ];\nuniform int use_global_palette;\nuniform uint global_palette;\n  \nvoid main()\n{\n    vec2 pixel = texture_coords * view_size;\n    final_color = vec4( 0.0, 0.0, 0.0, 0.0 );\n    // Composite from top layer down, stopping once nothing below can show through.\n    for ( int i = layer_count - 1; i >= 0; --i )\n    {\n        vec2 position = ( pixel + layer_offset[ i ] ) / TILE_SIZE;\n        if ( any( lessThan( position, vec2( 0.0, 0.0 ) ) ) || any( greaterThanEqual( position, map_size ) ) )\n        {\n            continue;\n        }\n        uvec4 tile = texelFetch( map_data, ivec3( ivec2( floor( position ) ), i ), 0 );\n        if ( tile.a == 255u )\n        {\n            continue;\n        }\n        if ( tile.a > 0u )\n        {\n            uvec4 frame = texelFetch( frame_data, ivec2( int( tile.a ), 0 ), 0 );\n            tile.xy = animation_table != 0 ? frame.xy : uvec2( tile.x + frame.r, tile.y );\n        }\n        ivec2 texel = ivec2( vec2( tile.xy ) * TILE_SIZE + floor( fract( position ) * TILE_SIZE ) );\n        float index = texelFetch( texture_data, texel, 0 ).r;\n        float palette = use_global_palette != 0 ? float( global_palette ) / 256.0 : float( tile.z ) / 255.0;\n        vec4 color = texture( palette_data, vec2( ( 255.0 / 256.0 ) * index, palette ) );\n        color.a *= layer_opacity[ i ];\n        final_color.rgb += ( 1.0 - final_color.a ) * color.a * color.rgb;\n        final_color.a += ( 1.0 - final_color.a ) * color.a;\n        if ( final_color.a >= 0.999 )\n        {\n            break;\n        }\n    }\n    final_color.rgb /= max( final_color.a, 0.0001 );\n}";
 static float animation_ticks_per_frame;
 
 
@@ -354,24 +702,63 @@ static int AddGraphic
     unsigned int layer,
     struct NasrGraphic graphic
 );
-static void AddTexture( Texture * texture, unsigned int texture_id, const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed );
+static int AddArrayTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels );
+static int AddAtlasTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels );
+static void AddTexture( Texture * texture, unsigned int texture_id, const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels );
+static int AddTextureFromFile( const TextureFileHeader * header, int sampling );
+static int AddTextureSlot( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels );
+static int AtlasPageFit( const AtlasPage * page, unsigned int i, unsigned int w, unsigned int h, unsigned int * y );
+static int AtlasPageInsert( AtlasPage * page, unsigned int w, unsigned int h, unsigned int * x, unsigned int * y );
+static void AttachTextureToFramebuffer( GLenum target, unsigned int texture );
+static void BakeTilemapChunk( NasrGraphicTilemap * tilemap, unsigned int vao, unsigned int chunk );
 static void BindBuffers( unsigned int id );
+static void BindTexture( unsigned int unit, GLuint texture );
+static void BindTextureArray( unsigned int unit, GLuint texture );
+static void BindTileAnimations( unsigned int texture, GLint frames, GLint animtable );
 static void BufferDefault( float * vptr );
 static void BufferVertices( float * vptr );
 static CharMapEntry * CharMapGenEntry( unsigned int id, const char * key );
 static CharMapEntry * CharMapHashFindEntry( unsigned int id, const char * needle_string, hash_t needle_hash );
 static uint32_t CharMapHashString( unsigned int id, const char * key );
 static void CharsetMalformedError( const char * msg, const char * file );
+static int CheckTextureUnpacked( const char * caller, unsigned int texture );
 static void ClearBufferBindings( void );
+static void ClearTileAnimations( Texture * texture );
+static void ClearTilemapBake( NasrGraphicTilemap * tilemap );
+static unsigned int CountTilemapSolidBits( const uint64_t * row, int x, int w );
+static GLuint CreateTextureArray( unsigned int width, unsigned int height, unsigned int layers, GLint sampling, GLint indexed );
 static void DestroyGraphic( NasrGraphic * graphic );
+static void DestroyChunkedTilemap( NasrGraphicChunkedTilemap * tilemap );
+static void DistanceTransform( float * grid, unsigned int width, unsigned int height );
+static void DistanceTransformLine( const float * f, float * d, int * v, float * z, unsigned int n );
+static int DrawBakedTilemap( NasrGraphicTilemap * tilemap, unsigned int vao, float scrollx, float scrolly );
 static void DrawBox( unsigned int vao, const NasrRect * rect, float scrollx, float scrolly );
+static void DrawChunkedTilemap( NasrGraphicChunkedTilemap * tilemap, const TilemapUniforms * uniforms, unsigned int vao, float scrollx, float scrolly );
+static void DrawTextStream( NasrGraphicTextStream * stream );
+static void EvictTextures( void );
+static void FillVerticesColorValues( float * vptr, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color );
+static const CharTemplate * FindCharTemplate( unsigned int charset, const char * s, int * len );
+static void FinishTextureLoads( void );
+static void FlushLayeredTilemap( NasrGraphicLayeredTilemap * tilemap );
+static void FlushTilemap( NasrGraphicTilemap * tilemap );
 static void FramebufferSizeCallback( GLFWwindow * window, int width, int height );
+static void GenerateDistanceField( unsigned char * data, unsigned int width, unsigned int height );
+static void GenerateCharsetDigitTable( unsigned int id );
 static unsigned int GenerateShaderProgram( const NasrShader * shaders, int shadersnum );
 static int GetCharacterSize( const char * s );
+static const CounterUniforms * GetCounterShader( const NasrGraphicCounter * counter, unsigned int * shader );
 static GLint GetGLRGBA( int indexed );
 static GLint GetGLSamplingType( int sampling );
 static NasrGraphic * GetGraphic( unsigned int id );
+static void GetSpriteTextureCoords( const NasrGraphicSprite * sprite, float * left, float * right, float * top, float * bottom );
 static unsigned int GetStateLayerIndex( unsigned int state, unsigned int layer );
+static const TextUniforms * GetTextShader( unsigned int charset, uint_fast8_t palette_type, unsigned int * shader );
+static unsigned int GetTextureChannels( int indexed );
+static const TextureFileHeader * GetTextureFileHeader( const void * data, size_t size );
+static size_t GetTextureFileLevelSize( const TextureFileHeader * header, unsigned int level );
+static unsigned int GetTextureStorage( unsigned int texture );
+static unsigned char * GetTilemapChunk( NasrGraphicChunkedTilemap * tilemap, unsigned int chunk );
+static int GetTilemapProgram( unsigned int tilew, unsigned int tileh );
 static float * GetVertices( unsigned int id );
 static int GraphicsAddCounter
 (
@@ -407,17 +794,56 @@ static int GraphicAddText
     uint_fast8_t palette,
     uint_fast8_t palette_type
 );
+static int GraphicAddTextStream
+(
+    float scrollx,
+    float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    NasrColor color,
+    uint_fast8_t palette,
+    uint_fast8_t palette_type
+);
 static void GraphicsRectGradientPaletteUpdateColors( unsigned int id, uint_fast8_t * c );
 static void GraphicsUpdateRectPalette( unsigned int id, uint_fast8_t color );
 static int GrowGraphics( void );
-static unsigned char * LoadTextureFileData( const char * filename, unsigned int * width, unsigned int * height, int sampling, int indexed );
+static int GrowTextureArray( TextureArray * array );
+static int IsTextureFile( const char * filename );
+static int LayoutTextStream( NasrGraphicTextStream * stream, const NasrText * text );
+static unsigned char * LoadTextureFileData( const char * filename, unsigned int * width, unsigned int * height, int sampling, int indexed, int baked );
+static void MarkTilemapDirty( NasrGraphicTilemap * tilemap, int x, int y, int w, int h );
+static int PackAtlasTexture( unsigned int texture, const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels );
+static int QueueTextureLoad( TextureLoadJob * job, const char * filename, int sampling, int indexed );
+static void RefreshSpritesForTexture( unsigned int texture );
+static void ReleaseTextureSlot( unsigned int texture );
+static int ReloadEvictedTexture( unsigned int texture );
+static void ResetTextureBindings( void );
 static void ResetVertices( float * vptr );
+static void SetCounterDigits( NasrGraphicCounter * counter, float n );
 static void SetShader( unsigned int shader );
+static void SetSpriteAtlasRect( const SpriteUniforms * uniforms, unsigned int texture );
+static void SetTextureFilters( GLenum target, GLint sampling, int mipmapped );
+static void SetTextureSource( unsigned int texture, const char * filename, int sampling, int indexed );
+static void SetTilemapTextureData( unsigned int texture_id, const unsigned char * data, unsigned int width, unsigned int height );
 static void SetVerticesColors( unsigned int id, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color );
 static void SetVerticesColorValues( float * vptr, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color );
 static void SetVerticesView( float x, float y, float scrollx, float scrolly );
 static void SetupVertices( unsigned int vao );
-static uint32_t TextureMapHashString( const char * key );
+static int StartTextureLoader( void );
+static void StopTextureLoader( void );
+static void * TextureLoaderWork( void * arg );
+static int TextureMapGrow( void );
+static hash_t TextureMapHashString( const char * key, uint32_t * length );
+static void TextureMapInsert( TextureMapEntry entry );
+static int TextureMapLookup( const char * filename, unsigned int value );
+static void TextureMapRemove( const char * filename );
+static int TextureMipmapped( GLint sampling, GLint indexed );
+static int TilemapHasAnimatedTiles( const NasrGraphicTilemap * tilemap );
+static int TilemapSolidAt( const NasrGraphicTilemap * tilemap, int x, int y );
+static void TouchTexture( unsigned int texture );
+static void UpdateAnimationFrames( void );
+static void UpdateCharVertices( float * vptr, const NasrRect * src, const Texture * texture );
 static void UpdateShaderOrtho( float x, float y, float w, float h );
 static void UpdateShaderOrthoToCamera( void );
 static void UpdateSpriteModel( unsigned int id );
@@ -425,6 +851,10 @@ static void UpdateSpriteVertices( unsigned int id );
 static void UpdateSpriteVerticesValues( float * vptr, const NasrGraphicSprite * sprite );
 static void UpdateSpriteX( unsigned int id );
 static void UpdateSpriteY( unsigned int id );
+static void UpdateTextureMipmaps( unsigned int texture );
+static int UpdateTileAnimationTable( TileAnimationTable * table );
+static void UpdateTilemapSolidity( NasrGraphicTilemap * tilemap, int x, int y, int w, int h );
+static void UploadTextStreamLine( NasrGraphicTextStream * stream, unsigned int line_id, unsigned int slot );
 
 
 
@@ -480,16 +910,37 @@ int NasrInit
     // Update viewport on window resize.
     glfwSetFramebufferSizeCallback( window, FramebufferSizeCallback );
 
+    // Loader threads check baked files’ sizes, but can’t ask GL themselves.
+    glGetIntegerv( GL_MAX_TEXTURE_SIZE, &max_texture_size );
+
+    // Anisotropic filtering is only used by mipmapped textures, & only if driver has it.
+    if ( glfwExtensionSupported( "GL_EXT_texture_filter_anisotropic" ) || glfwExtensionSupported( "GL_ARB_texture_filter_anisotropic" ) )
+    {
+        glGetFloatv( GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &texture_anisotropy );
+        texture_anisotropy = NASR_MATH_MIN( texture_anisotropy, MAX_TEXTURE_ANISOTROPY );
+    }
+
     // Turn on blending.
     glEnable( GL_BLEND );
     glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
 
     // Init textures list
-    max_textures = texture_map_size = init_max_textures;
+    max_textures = init_max_textures;
+    texture_map_size = TEXTURE_MAP_MIN_SIZE;
+    while ( texture_map_size < ( uint32_t )( init_max_textures ) * 2 )
+    {
+        texture_map_size *= 2;
+    }
     textures = calloc( max_textures, sizeof( Texture ) );
     texture_ids = calloc( max_textures, sizeof( unsigned int ) );
     glGenTextures( max_textures, texture_ids );
     glGenTextures( 1, &palette_texture_id );
+    glGenTextures( 1, &animation_frames_texture_id );
+    glBindTexture( GL_TEXTURE_2D, animation_frames_texture_id );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_R8UI, 256, 1, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, 0 );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+    UpdateAnimationFrames();
 
     max_graphics = init_max_graphics;
     vaos = calloc( ( max_graphics + 1 ), sizeof( unsigned int ) );
@@ -520,11 +971,7 @@ int NasrInit
     ClearBufferBindings();
 
     // Set up shaders
-    NasrShader vertex_shader =
-    {
-        NASR_SHADER_VERTEX,
-        "#version 330 core\n layout ( location = 0 ) in vec2 in_position;\n layout ( location = 1 ) in vec2 in_texture_coords;\n layout ( location = 2 ) in vec4 in_color;\n \n out vec2 texture_coords;\n out vec4 out_color;\n out vec2 out_position;\n \n uniform mat4 model;\n uniform mat4 view;\n uniform mat4 ortho;\n \n void main()\n {\n out_position = in_position;\n gl_Position = ortho * view * model * vec4( in_position, 0.0, 1.0 );\n texture_coords = in_texture_coords;\n out_color = in_color;\n }"
-    };
+    NasrShader vertex_shader = { NASR_SHADER_VERTEX, vertex_shader_code };
 
     NasrShader rect_shaders[] =
     {
@@ -540,7 +987,7 @@ int NasrInit
         vertex_shader,
         {
             NASR_SHADER_FRAGMENT,
-            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform float opacity;\nuniform vec2 tiling;\n  \nvoid main()\n{\n    final_color = texture( texture_data, texture_coords * tiling );\n    final_color.a *= opacity;\n}"
+            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform float opacity;\nuniform vec2 tiling;\nuniform vec4 atlas_rect;\n  \nvoid main()\n{\n    vec2 coords = texture_coords * tiling;\n    if ( atlas_rect.z > 0.0 )\n    {\n        coords = atlas_rect.xy + fract( ( texture_coords - atlas_rect.xy ) / atlas_rect.zw * tiling ) * atlas_rect.zw;\n    }\n    final_color = texture( texture_data, coords );\n    final_color.a *= opacity;\n}"
         }
     };
 
@@ -549,25 +996,25 @@ int NasrInit
         vertex_shader,
         {
             NASR_SHADER_FRAGMENT,
-            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform float palette_id;\nuniform float opacity;\nuniform vec2 tiling;\n\nvoid main()\n{\n    vec4 index = texture( texture_data, texture_coords * tiling );\n    float palette = palette_id / 256.0;\n    final_color = texture( palette_data, vec2( ( 255.0 / 256.0 ) * index.r, palette ) );\n    final_color.a *= opacity;\n}"
+            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform float palette_id;\nuniform float opacity;\nuniform vec2 tiling;\nuniform vec4 atlas_rect;\n\nvoid main()\n{\n    vec2 coords = texture_coords * tiling;\n    if ( atlas_rect.z > 0.0 )\n    {\n        coords = atlas_rect.xy + fract( ( texture_coords - atlas_rect.xy ) / atlas_rect.zw * tiling ) * atlas_rect.zw;\n    }\n    vec4 index = texture( texture_data, coords );\n    float palette = palette_id / 256.0;\n    final_color = texture( palette_data, vec2( ( 255.0 / 256.0 ) * index.r, palette ) );\n    final_color.a *= opacity;\n}"
         }
     };
 
-    NasrShader tilemap_shaders[] =
+    NasrShader array_sprite_shaders[] =
     {
         vertex_shader,
         {
             NASR_SHADER_FRAGMENT,
-            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform sampler2D map_data;\nuniform float map_width;\nuniform float map_height;\nuniform float tileset_width;\nuniform float tileset_height;\nuniform float opacity;\nuniform uint animation;\nuniform vec2 tiling;\n  \nvoid main()\n{\n    vec2 tc = texture_coords * tiling;\n    vec4 tile = texture( map_data, tc );\n    if ( tile.a > 0.0 && tile.a < 1.0 )\n    {\n        float frames = floor( tile.a * 255.0 );\n        float frame = mod( float( animation ), frames );\n        // I don’t know why mod sometimes doesn’t work right & still sometimes says 6 is the mod o’ 6 / 6 ’stead o’ 0;\n        // This fixes it.\n        while ( frame >= frames )\n        {\n            frame -= frames;\n        }\n        tile.x += frame / 255.0;\n    }\n    float xrel = mod( tc.x * 256.0, ( 256.0 / map_width ) ) / ( 4096.0 / map_width );\n    float yrel = mod( tc.y * 256.0, ( 256.0 / map_height ) ) / ( 4096.0 / map_height );\n    float xoffset = tile.x * 255.0 * ( 16 / tileset_width );\n    float yoffset = tile.y * 255.0 * ( 16 / tileset_height );\n    float palette = tile.z;\n    vec4 index = texture( texture_data, vec2( xoffset + ( xrel / ( tileset_width / 256.0 ) ), yoffset + ( yrel / ( tileset_height / 256.0 ) ) ) );\n    final_color = ( tile.a < 1.0 ) ? texture( palette_data, vec2( ( 255.0 / 256.0 ) * index.r, palette ) ) : vec4( 0.0, 0.0, 0.0, 0.0 );\n    final_color.a *= opacity;\n}"
+            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2DArray texture_data;\nuniform float layer;\nuniform float opacity;\nuniform vec2 tiling;\n  \nvoid main()\n{\n    final_color = texture( texture_data, vec3( texture_coords * tiling, layer ) );\n    final_color.a *= opacity;\n}"
         }
     };
 
-    NasrShader tilemap_mono_shaders[] =
+    NasrShader indexed_array_sprite_shaders[] =
     {
         vertex_shader,
         {
             NASR_SHADER_FRAGMENT,
-            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform sampler2D map_data;\nuniform float map_width;\nuniform float map_height;\nuniform float tileset_width;\nuniform float tileset_height;\nuniform float opacity;\nuniform uint animation;\nuniform uint global_palette;\nuniform vec2 tiling;\n  \nvoid main()\n{\n    vec2 tc = texture_coords * tiling;\n    vec4 tile = texture( map_data, tc );\n    if ( tile.a < 1.0 || opacity > 0.0 )\n    {\n        if ( tile.a > 0.0 && tile.a < 1.0 )\n        {\n            float frames = floor( tile.a * 255.0 );\n            float frame = mod( float( animation ), frames );\n            // I don’t know why mod sometimes doesn’t work right & still sometimes says 6 is the mod o’ 6 / 6 ’stead o’ 0;\n            // This fixes it.\n            while ( frame >= frames )\n            {\n                frame -= frames;\n            }\n            tile.x += frame / 255.0;\n        }\n        float xrel = mod( tc.x * 256.0, ( 256.0 / map_width ) ) / ( 4096.0 / map_width );\n        float yrel = mod( tc.y * 256.0, ( 256.0 / map_height ) ) / ( 4096.0 / map_height );\n        float xoffset = tile.x * 255.0 * ( 16 / tileset_width );\n        float yoffset = tile.y * 255.0 * ( 16 / tileset_height );\n        float palette = float( global_palette ) / 256.0;\n        vec4 index = texture( texture_data, vec2( xoffset + ( xrel / ( tileset_width / 256.0 ) ), yoffset + ( yrel / ( tileset_height / 256.0 ) ) ) );\n        final_color = ( tile.a < 1.0 ) ? texture( palette_data, vec2( ( 255.0 / 256.0 ) * index.r, palette ) ) : vec4( 0.0, 0.0, 0.0, 0.0 );\n        final_color.a *= opacity;\n    }\n}"
+            "#version 330 core\nout vec4 final_color;\n\nin vec2 texture_coords;\n\nuniform sampler2DArray texture_data;\nuniform sampler2D palette_data;\nuniform float layer;\nuniform float palette_id;\nuniform float opacity;\nuniform vec2 tiling;\n\nvoid main()\n{\n    vec4 index = texture( texture_data, vec3( texture_coords * tiling, layer ) );\n    float palette = palette_id / 256.0;\n    final_color = texture( palette_data, vec2( ( 255.0 / 256.0 ) * index.r, palette ) );\n    final_color.a *= opacity;\n}"
         }
     };
 
@@ -598,54 +1045,107 @@ int NasrInit
         }
     };
     
+    NasrShader text_sdf_shaders[] =
+    {
+        vertex_shader,
+        {
+            NASR_SHADER_FRAGMENT,
+            "#version 330 core\nout vec4 final_color;\n\nin vec4 out_color;\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform float opacity;\nuniform float shadow;\nuniform vec2 shadow_offset;\n\nvoid main()\n{\n    float distance = texture( texture_data, texture_coords ).a;\n    float smoothing = max( fwidth( distance ) * 0.75, 0.001 );\n    float body = smoothstep( 0.5 - smoothing, 0.5 + smoothing, distance );\n    float shadow_distance = texture( texture_data, texture_coords - shadow_offset ).a;\n    float shadow_alpha = smoothstep( 0.5 - smoothing, 0.5 + smoothing, shadow_distance ) * shadow;\n    final_color = mix( vec4( 0.0, 0.0, 0.0, shadow_alpha ), vec4( out_color.rgb, out_color.a * opacity ), body );\n}"
+        }
+    };
+
+    NasrShader text_sdf_pal_shaders[] =
+    {
+        vertex_shader,
+        {
+            NASR_SHADER_FRAGMENT,
+            "#version 330 core\nout vec4 final_color;\n\nin vec4 out_color;\nin vec2 texture_coords;\n\nuniform sampler2D texture_data;\nuniform sampler2D palette_data;\nuniform float palette_id;\nuniform float opacity;\nuniform float shadow;\nuniform vec2 shadow_offset;\n\nvoid main()\n{\n    float palette = palette_id / 256.0;\n    vec4 color = texture( palette_data, vec2( ( 255.0 / 256.0 ) * out_color.r, palette ) );\n    float distance = texture( texture_data, texture_coords ).a;\n    float smoothing = max( fwidth( distance ) * 0.75, 0.001 );\n    float body = smoothstep( 0.5 - smoothing, 0.5 + smoothing, distance );\n    float shadow_distance = texture( texture_data, texture_coords - shadow_offset ).a;\n    float shadow_alpha = smoothstep( 0.5 - smoothing, 0.5 + smoothing, shadow_distance ) * shadow;\n    final_color = mix( vec4( 0.0, 0.0, 0.0, shadow_alpha ), vec4( color.rgb, color.a * opacity ), body );\n}"
+        }
+    };
+
+    NasrShader counter_vertex_shader =
+    {
+        NASR_SHADER_VERTEX,
+        "#version 330 core\n layout ( location = 0 ) in vec2 in_position;\n layout ( location = 1 ) in vec2 in_texture_coords;\n layout ( location = 2 ) in vec4 in_color;\n \n out vec2 texture_coords;\n out vec4 out_color;\n \n uniform mat4 view;\n uniform mat4 ortho;\n uniform int digits[ 32 ];\n uniform vec4 digit_src[ 12 ];\n uniform vec4 digit_dest[ 12 ];\n uniform float digit_width;\n \n void main()\n {\n int digit = digits[ gl_InstanceID ];\n vec4 dest = digit_dest[ digit ];\n vec4 src = digit_src[ digit ];\n vec2 position = vec2( digit_width * float( gl_InstanceID ), 0.0 ) + dest.xy + in_texture_coords * dest.zw;\n gl_Position = ortho * view * vec4( position, 0.0, 1.0 );\n texture_coords = src.xy + in_texture_coords * src.zw;\n out_color = in_color;\n }"
+    };
+
+    NasrShader counter_shaders[] =
+    {
+        counter_vertex_shader,
+        text_shaders[ 1 ]
+    };
+
+    NasrShader counter_pal_shaders[] =
+    {
+        counter_vertex_shader,
+        text_pal_shaders[ 1 ]
+    };
+
+    NasrShader counter_sdf_shaders[] =
+    {
+        counter_vertex_shader,
+        text_sdf_shaders[ 1 ]
+    };
+
+    NasrShader counter_sdf_pal_shaders[] =
+    {
+        counter_vertex_shader,
+        text_sdf_pal_shaders[ 1 ]
+    };
+    
     rect_shader = GenerateShaderProgram( rect_shaders, 2 );
     sprite_shader = GenerateShaderProgram( sprite_shaders, 2 );
     indexed_sprite_shader = GenerateShaderProgram( indexed_sprite_shaders, 2 );
-    tilemap_shader = GenerateShaderProgram( tilemap_shaders, 2 );
-    tilemap_mono_shader = GenerateShaderProgram( tilemap_mono_shaders, 2 );
+    array_sprite_shader = GenerateShaderProgram( array_sprite_shaders, 2 );
+    indexed_array_sprite_shader = GenerateShaderProgram( indexed_array_sprite_shaders, 2 );
     text_shader = GenerateShaderProgram( text_shaders, 2 );
     text_pal_shader = GenerateShaderProgram( text_pal_shaders, 2 );
     rect_pal_shader = GenerateShaderProgram( rect_pal_shaders, 2 );
+    counter_shader = GenerateShaderProgram( counter_shaders, 2 );
+    counter_pal_shader = GenerateShaderProgram( counter_pal_shaders, 2 );
+    text_sdf_shader = GenerateShaderProgram( text_sdf_shaders, 2 );
+    text_sdf_pal_shader = GenerateShaderProgram( text_sdf_pal_shaders, 2 );
+    counter_sdf_shader = GenerateShaderProgram( counter_sdf_shaders, 2 );
+    counter_sdf_pal_shader = GenerateShaderProgram( counter_sdf_pal_shaders, 2 );
+
+    // Tilemap programs are built per tile size; 16x16 is always 1st so chunked tilemaps can rely on it.
+    if ( GetTilemapProgram( 16, 16 ) < 0 )
+    {
+        return -1;
+    }
 
     // Store uniforms for use during rendering.
     sprite_uniforms.model        = glGetUniformLocation( sprite_shader, "model" );
     sprite_uniforms.opacity      = glGetUniformLocation( sprite_shader, "opacity" );
     sprite_uniforms.texture_data = glGetUniformLocation( sprite_shader, "texture_data" );
     sprite_uniforms.tiling       = glGetUniformLocation( sprite_shader, "tiling" );
+    sprite_uniforms.atlas_rect   = glGetUniformLocation( sprite_shader, "atlas_rect" );
     indexed_sprite_uniforms.model        = glGetUniformLocation( indexed_sprite_shader, "model" );
     indexed_sprite_uniforms.palette_id   = glGetUniformLocation( indexed_sprite_shader, "palette_id" );
     indexed_sprite_uniforms.opacity      = glGetUniformLocation( indexed_sprite_shader, "opacity" );
     indexed_sprite_uniforms.texture_data = glGetUniformLocation( indexed_sprite_shader, "texture_data" );
     indexed_sprite_uniforms.palette_data = glGetUniformLocation( indexed_sprite_shader, "palette_data" );
     indexed_sprite_uniforms.tiling       = glGetUniformLocation( indexed_sprite_shader, "tiling" );
+    indexed_sprite_uniforms.atlas_rect   = glGetUniformLocation( indexed_sprite_shader, "atlas_rect" );
+    array_sprite_uniforms.model        = glGetUniformLocation( array_sprite_shader, "model" );
+    array_sprite_uniforms.opacity      = glGetUniformLocation( array_sprite_shader, "opacity" );
+    array_sprite_uniforms.texture_data = glGetUniformLocation( array_sprite_shader, "texture_data" );
+    array_sprite_uniforms.tiling       = glGetUniformLocation( array_sprite_shader, "tiling" );
+    array_sprite_uniforms.atlas_rect   = -1;
+    array_sprite_uniforms.layer        = glGetUniformLocation( array_sprite_shader, "layer" );
+    indexed_array_sprite_uniforms.model        = glGetUniformLocation( indexed_array_sprite_shader, "model" );
+    indexed_array_sprite_uniforms.palette_id   = glGetUniformLocation( indexed_array_sprite_shader, "palette_id" );
+    indexed_array_sprite_uniforms.opacity      = glGetUniformLocation( indexed_array_sprite_shader, "opacity" );
+    indexed_array_sprite_uniforms.texture_data = glGetUniformLocation( indexed_array_sprite_shader, "texture_data" );
+    indexed_array_sprite_uniforms.palette_data = glGetUniformLocation( indexed_array_sprite_shader, "palette_data" );
+    indexed_array_sprite_uniforms.tiling       = glGetUniformLocation( indexed_array_sprite_shader, "tiling" );
+    indexed_array_sprite_uniforms.atlas_rect   = -1;
+    indexed_array_sprite_uniforms.layer        = glGetUniformLocation( indexed_array_sprite_shader, "layer" );
     rect_uniforms.model = glGetUniformLocation( rect_shader, "model" );
     rect_pal_uniforms.model        = glGetUniformLocation( rect_pal_shader, "model" );
     rect_pal_uniforms.palette_id   = glGetUniformLocation( rect_pal_shader, "palette_id" );
     rect_pal_uniforms.palette_data = glGetUniformLocation( rect_pal_shader, "palette_data" );
     rect_pal_uniforms.opacity      = glGetUniformLocation( rect_pal_shader, "opacity" );
-    tilemap_uniforms.model     = glGetUniformLocation( tilemap_shader, "model" );
-    tilemap_uniforms.mapw      = glGetUniformLocation( tilemap_shader, "map_width" );
-    tilemap_uniforms.maph      = glGetUniformLocation( tilemap_shader, "map_height" );
-    tilemap_uniforms.tilesetw  = glGetUniformLocation( tilemap_shader, "tileset_width" );
-    tilemap_uniforms.tileseth  = glGetUniformLocation( tilemap_shader, "tileset_height" );
-    tilemap_uniforms.animation = glGetUniformLocation( tilemap_shader, "animation" );
-    tilemap_uniforms.opacity   = glGetUniformLocation( tilemap_shader, "opacity" );
-    tilemap_uniforms.texture   = glGetUniformLocation( tilemap_shader, "texture_data" );
-    tilemap_uniforms.palette   = glGetUniformLocation( tilemap_shader, "palette_data" );
-    tilemap_uniforms.mapdata   = glGetUniformLocation( tilemap_shader, "map_data" );
-    tilemap_uniforms.tiling   = glGetUniformLocation( tilemap_shader, "tiling" );
-    tilemap_mono_uniforms.model     = glGetUniformLocation( tilemap_mono_shader, "model" );
-    tilemap_mono_uniforms.mapw      = glGetUniformLocation( tilemap_mono_shader, "map_width" );
-    tilemap_mono_uniforms.maph      = glGetUniformLocation( tilemap_mono_shader, "map_height" );
-    tilemap_mono_uniforms.tilesetw  = glGetUniformLocation( tilemap_mono_shader, "tileset_width" );
-    tilemap_mono_uniforms.tileseth  = glGetUniformLocation( tilemap_mono_shader, "tileset_height" );
-    tilemap_mono_uniforms.animation = glGetUniformLocation( tilemap_mono_shader, "animation" );
-    tilemap_mono_uniforms.opacity   = glGetUniformLocation( tilemap_mono_shader, "opacity" );
-    tilemap_mono_uniforms.texture   = glGetUniformLocation( tilemap_mono_shader, "texture_data" );
-    tilemap_mono_uniforms.palette   = glGetUniformLocation( tilemap_mono_shader, "palette_data" );
-    tilemap_mono_uniforms.mapdata   = glGetUniformLocation( tilemap_mono_shader, "map_data" );
-    tilemap_mono_uniforms.globalpal = glGetUniformLocation( tilemap_mono_shader, "global_palette" );
-    tilemap_mono_uniforms.tiling    = glGetUniformLocation( tilemap_mono_shader, "tiling" );
     text_uniforms.texture = glGetUniformLocation( text_shader, "texture_data" );
     text_uniforms.shadow = glGetUniformLocation( text_shader, "shadow" );
     text_uniforms.opacity = glGetUniformLocation( text_shader, "opacity" );
@@ -658,6 +1158,58 @@ int NasrInit
     text_pal_uniforms.palette_id   = glGetUniformLocation( text_pal_shader, "palette_id" );
     text_pal_uniforms.palette_data = glGetUniformLocation( text_pal_shader, "palette_data" );
     text_pal_uniforms.model        = glGetUniformLocation( text_pal_shader, "model" );
+    counter_uniforms.texture     = glGetUniformLocation( counter_shader, "texture_data" );
+    counter_uniforms.shadow      = glGetUniformLocation( counter_shader, "shadow" );
+    counter_uniforms.opacity     = glGetUniformLocation( counter_shader, "opacity" );
+    counter_uniforms.palette_id   = glGetUniformLocation( counter_shader, "palette_id" );
+    counter_uniforms.palette_data = glGetUniformLocation( counter_shader, "palette_data" );
+    counter_uniforms.digits      = glGetUniformLocation( counter_shader, "digits" );
+    counter_uniforms.digit_src   = glGetUniformLocation( counter_shader, "digit_src" );
+    counter_uniforms.digit_dest  = glGetUniformLocation( counter_shader, "digit_dest" );
+    counter_uniforms.digit_width = glGetUniformLocation( counter_shader, "digit_width" );
+    counter_pal_uniforms.texture      = glGetUniformLocation( counter_pal_shader, "texture_data" );
+    counter_pal_uniforms.shadow       = glGetUniformLocation( counter_pal_shader, "shadow" );
+    counter_pal_uniforms.opacity      = glGetUniformLocation( counter_pal_shader, "opacity" );
+    counter_pal_uniforms.palette_id   = glGetUniformLocation( counter_pal_shader, "palette_id" );
+    counter_pal_uniforms.palette_data = glGetUniformLocation( counter_pal_shader, "palette_data" );
+    counter_pal_uniforms.digits       = glGetUniformLocation( counter_pal_shader, "digits" );
+    counter_pal_uniforms.digit_src    = glGetUniformLocation( counter_pal_shader, "digit_src" );
+    counter_pal_uniforms.digit_dest   = glGetUniformLocation( counter_pal_shader, "digit_dest" );
+    counter_pal_uniforms.digit_width  = glGetUniformLocation( counter_pal_shader, "digit_width" );
+    text_sdf_uniforms.texture       = glGetUniformLocation( text_sdf_shader, "texture_data" );
+    text_sdf_uniforms.shadow        = glGetUniformLocation( text_sdf_shader, "shadow" );
+    text_sdf_uniforms.opacity       = glGetUniformLocation( text_sdf_shader, "opacity" );
+    text_sdf_uniforms.palette_id    = glGetUniformLocation( text_sdf_shader, "palette_id" );
+    text_sdf_uniforms.palette_data  = glGetUniformLocation( text_sdf_shader, "palette_data" );
+    text_sdf_uniforms.model         = glGetUniformLocation( text_sdf_shader, "model" );
+    text_sdf_uniforms.shadow_offset = glGetUniformLocation( text_sdf_shader, "shadow_offset" );
+    text_sdf_pal_uniforms.texture       = glGetUniformLocation( text_sdf_pal_shader, "texture_data" );
+    text_sdf_pal_uniforms.shadow        = glGetUniformLocation( text_sdf_pal_shader, "shadow" );
+    text_sdf_pal_uniforms.opacity       = glGetUniformLocation( text_sdf_pal_shader, "opacity" );
+    text_sdf_pal_uniforms.palette_id    = glGetUniformLocation( text_sdf_pal_shader, "palette_id" );
+    text_sdf_pal_uniforms.palette_data  = glGetUniformLocation( text_sdf_pal_shader, "palette_data" );
+    text_sdf_pal_uniforms.model         = glGetUniformLocation( text_sdf_pal_shader, "model" );
+    text_sdf_pal_uniforms.shadow_offset = glGetUniformLocation( text_sdf_pal_shader, "shadow_offset" );
+    counter_sdf_uniforms.texture       = glGetUniformLocation( counter_sdf_shader, "texture_data" );
+    counter_sdf_uniforms.shadow        = glGetUniformLocation( counter_sdf_shader, "shadow" );
+    counter_sdf_uniforms.opacity       = glGetUniformLocation( counter_sdf_shader, "opacity" );
+    counter_sdf_uniforms.palette_id    = glGetUniformLocation( counter_sdf_shader, "palette_id" );
+    counter_sdf_uniforms.palette_data  = glGetUniformLocation( counter_sdf_shader, "palette_data" );
+    counter_sdf_uniforms.digits        = glGetUniformLocation( counter_sdf_shader, "digits" );
+    counter_sdf_uniforms.digit_src     = glGetUniformLocation( counter_sdf_shader, "digit_src" );
+    counter_sdf_uniforms.digit_dest    = glGetUniformLocation( counter_sdf_shader, "digit_dest" );
+    counter_sdf_uniforms.digit_width   = glGetUniformLocation( counter_sdf_shader, "digit_width" );
+    counter_sdf_uniforms.shadow_offset = glGetUniformLocation( counter_sdf_shader, "shadow_offset" );
+    counter_sdf_pal_uniforms.texture       = glGetUniformLocation( counter_sdf_pal_shader, "texture_data" );
+    counter_sdf_pal_uniforms.shadow        = glGetUniformLocation( counter_sdf_pal_shader, "shadow" );
+    counter_sdf_pal_uniforms.opacity       = glGetUniformLocation( counter_sdf_pal_shader, "opacity" );
+    counter_sdf_pal_uniforms.palette_id    = glGetUniformLocation( counter_sdf_pal_shader, "palette_id" );
+    counter_sdf_pal_uniforms.palette_data  = glGetUniformLocation( counter_sdf_pal_shader, "palette_data" );
+    counter_sdf_pal_uniforms.digits        = glGetUniformLocation( counter_sdf_pal_shader, "digits" );
+    counter_sdf_pal_uniforms.digit_src     = glGetUniformLocation( counter_sdf_pal_shader, "digit_src" );
+    counter_sdf_pal_uniforms.digit_dest    = glGetUniformLocation( counter_sdf_pal_shader, "digit_dest" );
+    counter_sdf_pal_uniforms.digit_width   = glGetUniformLocation( counter_sdf_pal_shader, "digit_width" );
+    counter_sdf_pal_uniforms.shadow_offset = glGetUniformLocation( counter_sdf_pal_shader, "shadow_offset" );
 
     // Init camera
     NasrResetCamera();
@@ -679,8 +1231,10 @@ int NasrInit
         gfx_ptrs_id_to_pos[ i ] = gfx_ptrs_pos_to_id[ i ] = state_for_gfx[ i ] = layer_for_gfx[ i ] = -1;
     }
 
-    // Init framebuffer.
+    // Init framebuffers.
     glGenFramebuffers( 1, &framebuffer );
+    glGenFramebuffers( 1, &bake_framebuffer );
+    glGenFramebuffers( 2, copy_framebuffers );
 
     magnified_canvas_width = canvas.w * magnification;
     magnified_canvas_height = canvas.h * magnification;
@@ -699,6 +1253,17 @@ int NasrInit
 
 void NasrClose( void )
 {
+    StopTextureLoader();
+
+    // Tilemap programs are built lazily, so clear them out fully or next NasrInit would reuse dead names.
+    for ( unsigned int i = 0; i < tilemap_program_count; ++i )
+    {
+        glDeleteProgram( tilemap_programs[ i ].shader );
+        glDeleteProgram( tilemap_programs[ i ].mono_shader );
+        glDeleteProgram( tilemap_programs[ i ].layered_shader );
+    }
+    tilemap_program_count = 0;
+
     #ifdef NASR_DEBUG
         // Close charmaps
         if ( charmaps.list )
@@ -709,6 +1274,10 @@ void NasrClose( void )
             }
             free( charmaps.list );
         }
+        if ( charset_atlas_id )
+        {
+            glDeleteTextures( 1, &charset_atlas_id );
+        }
 
         for ( int i = 0; i < num_o_graphics; ++i )
         {
@@ -727,10 +1296,14 @@ void NasrClose( void )
         }
         free( vertices );
         glDeleteFramebuffers( 1, &framebuffer );
+        glDeleteFramebuffers( 1, &bake_framebuffer );
+        glDeleteFramebuffers( 2, copy_framebuffers );
         NasrClearTextures();
         free( texture_map );
+        free( texture_names );
         free( textures );
         glDeleteTextures( 1, &palette_texture_id );
+        glDeleteTextures( 1, &animation_frames_texture_id );
         if ( texture_ids )
         {
             glDeleteTextures( max_textures, texture_ids );
@@ -750,6 +1323,9 @@ void NasrUpdate( float dt )
 {
     glClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
     glClear( GL_COLOR_BUFFER_BIT );
+    ++texture_frame;
+    FinishTextureLoads();
+    ResetTextureBindings();
 
     // Only update ortho if camera has moved.
     if ( camera.x != prev_camera.x || camera.y != prev_camera.y )
@@ -821,8 +1397,7 @@ void NasrUpdate( float dt )
                 glUniform1f( rect_pal_uniforms.opacity, graphics[ i ].data.rectpal.opacity );
 
                 // Set palette texture.
-                glActiveTexture( GL_TEXTURE1 );
-                glBindTexture( GL_TEXTURE_2D, palette_texture_id );
+                BindTexture( 1, palette_texture_id );
                 glUniform1i( rect_pal_uniforms.palette_data, 1 );
                 
                 SetupVertices( vao );
@@ -859,11 +1434,13 @@ void NasrUpdate( float dt )
                     continue;
                 }
 
-                // Set shader.
-                const SpriteUniforms * shader_uniforms = textures[ texture_id ].indexed
-                    ? &indexed_sprite_uniforms
-                    : &sprite_uniforms;
-                const unsigned int shader = textures[ texture_id ].indexed ? indexed_sprite_shader : sprite_shader;
+                // Set shader; array textures have their own that pick layer out o’ shared texture.
+                const SpriteUniforms * shader_uniforms = textures[ texture_id ].layered
+                    ? ( textures[ texture_id ].indexed ? &indexed_array_sprite_uniforms : &array_sprite_uniforms )
+                    : ( textures[ texture_id ].indexed ? &indexed_sprite_uniforms : &sprite_uniforms );
+                const unsigned int shader = textures[ texture_id ].layered
+                    ? ( textures[ texture_id ].indexed ? indexed_array_sprite_shader : array_sprite_shader )
+                    : ( textures[ texture_id ].indexed ? indexed_sprite_shader : sprite_shader );
                 SetShader( shader );
 
                 // Set view.
@@ -880,13 +1457,22 @@ void NasrUpdate( float dt )
 
                 // Set tiling.
                 glUniform2f( shader_uniforms->tiling, SPRITE.tilingx, SPRITE.tilingy );
+                SetSpriteAtlasRect( shader_uniforms, texture_id );
 
                 // Set opacity.
                 glUniform1f( shader_uniforms->opacity, ( float )( SPRITE.opacity ) );
 
-                // Set texture.
-                glActiveTexture( GL_TEXTURE0 );
-                glBindTexture( GL_TEXTURE_2D, texture_ids[ texture_id ] );
+                // Set texture. Atlas & array textures bind what they share, so sprites sharing it skip rebinding.
+                TouchTexture( texture_id );
+                if ( textures[ texture_id ].layered )
+                {
+                    BindTextureArray( 0, texture_arrays[ textures[ texture_id ].array ].id );
+                    glUniform1f( shader_uniforms->layer, ( float )( textures[ texture_id ].layer ) );
+                }
+                else
+                {
+                    BindTexture( 0, texture_ids[ GetTextureStorage( texture_id ) ] );
+                }
                 glUniform1i( shader_uniforms->texture_data, 0 );
 
                 // Set palette ID & texture if set to indexed.
@@ -895,8 +1481,7 @@ void NasrUpdate( float dt )
                     const float palette = ( float )( SPRITE.useglobalpal ? global_palette : SPRITE.palette );
                     glUniform1f( shader_uniforms->palette_id, palette );
 
-                    glActiveTexture( GL_TEXTURE1);
-                    glBindTexture( GL_TEXTURE_2D, palette_texture_id );
+                    BindTexture( 1, palette_texture_id );
                     glUniform1i( shader_uniforms->palette_data, 1 );
                 }
                 
@@ -917,9 +1502,19 @@ void NasrUpdate( float dt )
                     continue;
                 }
 
+                // Tileset counts as used e’en when baked, since rebaking needs it.
+                TouchTexture( TG.texture );
+
+                // Draw as plain sprites if map is baked.
+                if ( TG.bake && DrawBakedTilemap( &TG, vao, graphics[ i ].scrollx, graphics[ i ].scrolly ) == 0 )
+                {
+                    break;
+                }
+
                 // Set shader.
-                const unsigned int shader = TG.useglobalpal ? tilemap_mono_shader : tilemap_shader;
-                const TilemapUniforms * uniforms = TG.useglobalpal ? &tilemap_mono_uniforms : &tilemap_uniforms;
+                const TilemapProgram * program = &tilemap_programs[ TG.program ];
+                const unsigned int shader = TG.useglobalpal ? program->mono_shader : program->shader;
+                const TilemapUniforms * uniforms = TG.useglobalpal ? &program->mono_uniforms : &program->uniforms;
                 SetShader( shader );
 
                 // Set view.
@@ -940,39 +1535,26 @@ void NasrUpdate( float dt )
                 // Set tiling.
                 glUniform2f( uniforms->tiling, TG.tilingx, TG.tilingy );
 
-                // Set map width.
-                const float mapw = ( float )( textures[ TG.tilemap ].width );
-                glUniform1f( uniforms->mapw, mapw );
-
-                // Set map height.
-                const float maph = ( float )( textures[ TG.tilemap ].height );
-                glUniform1f( uniforms->maph, maph );
+                // Set map size.
+                glUniform2f( uniforms->map_size, ( float )( textures[ TG.tilemap ].width ), ( float )( textures[ TG.tilemap ].height ) );
 
-                // Set tileset width.
-                glUniform1f( uniforms->tilesetw, ( float )( textures[ TG.texture ].width ) );
-
-                // Set tileset height.
-                glUniform1f( uniforms->tileseth, ( float )( textures[ TG.texture ].height ) );
-
-                // Set animation counter.
-                glUniform1ui( uniforms->animation, animation_frame );
+                // Set animation frame table.
+                BindTileAnimations( TG.texture, uniforms->frames, uniforms->animtable );
 
                 // Set opacity.
                 glUniform1f( uniforms->opacity, TG.opacity );
 
                 // Set tileset texture.
-                glActiveTexture( GL_TEXTURE0 );
-                glBindTexture( GL_TEXTURE_2D, texture_ids[ TG.texture ] );
+                BindTexture( 0, texture_ids[ TG.texture ] );
                 glUniform1i( uniforms->texture, 0 );
 
                 // Set palette texture.
-                glActiveTexture( GL_TEXTURE1 );
-                glBindTexture( GL_TEXTURE_2D, palette_texture_id );
+                BindTexture( 1, palette_texture_id );
                 glUniform1i( uniforms->palette, 1 );
 
-                // Set tilemap texture.
-                glActiveTexture( GL_TEXTURE2 );
-                glBindTexture( GL_TEXTURE_2D, texture_ids[ TG.tilemap ] );
+                // Set tilemap texture, uploading any tiles changed since last frame.
+                FlushTilemap( &TG );
+                BindTexture( 2, texture_ids[ TG.tilemap ] );
                 glUniform1i( uniforms->mapdata, 2 );
 
                 // If using global palette, set its ID.
@@ -986,22 +1568,141 @@ void NasrUpdate( float dt )
                 #undef TG
             }
             break;
+            case ( NASR_GRAPHIC_TILEMAP_CHUNKED ):
+            {
+                #define TC graphics[ i ].data.chunked
+
+                if ( TC->texture >= max_textures )
+                {
+                    NasrLog( "NasrUpdate Error: Invalid texture #%u beyond limit.", TC->texture );
+                    continue;
+                }
+
+                // Set shader.
+                // Chunked tilemaps always use 16x16 tiles, which is always 1st program.
+                const TilemapProgram * program = &tilemap_programs[ 0 ];
+                const unsigned int shader = TC->useglobalpal ? program->mono_shader : program->shader;
+                const TilemapUniforms * uniforms = TC->useglobalpal ? &program->mono_uniforms : &program->uniforms;
+                SetShader( shader );
+
+                // Set scale; every chunk is same size.
+                mat4 model = BASE_MATRIX;
+                vec3 scale = { TILEMAP_CHUNK_PIXELS, TILEMAP_CHUNK_PIXELS, 0.0 };
+                glm_scale( model, scale );
+                glUniformMatrix4fv( uniforms->model, 1, GL_FALSE, ( float * )( model ) );
+
+                // Set tiling & map size to 1 chunk.
+                glUniform2f( uniforms->tiling, 1.0f, 1.0f );
+                glUniform2f( uniforms->map_size, ( float )( TILEMAP_CHUNK_SIZE ), ( float )( TILEMAP_CHUNK_SIZE ) );
+
+                // Set animation frame table.
+                BindTileAnimations( TC->texture, uniforms->frames, uniforms->animtable );
+
+                // Set opacity.
+                glUniform1f( uniforms->opacity, TC->opacity );
+
+                // Set tileset texture.
+                TouchTexture( TC->texture );
+                BindTexture( 0, texture_ids[ TC->texture ] );
+                glUniform1i( uniforms->texture, 0 );
+
+                // Set palette texture.
+                BindTexture( 1, palette_texture_id );
+                glUniform1i( uniforms->palette, 1 );
+
+                // If using global palette, set its ID.
+                if ( TC->useglobalpal )
+                {
+                    glUniform1ui( uniforms->globalpal, ( GLuint )( global_palette ) );
+                }
+
+                // Stream in chunks near camera & draw those on screen.
+                DrawChunkedTilemap( TC, uniforms, vao, graphics[ i ].scrollx, graphics[ i ].scrolly );
+
+                #undef TC
+            }
+            break;
+            case ( NASR_GRAPHIC_TILEMAP_LAYERED ):
+            {
+                #define TL graphics[ i ].data.layered
+
+                if ( TL->texture >= max_textures )
+                {
+                    NasrLog( "NasrUpdate Error: Invalid texture #%u beyond limit.", TL->texture );
+                    continue;
+                }
+
+                // Set shader.
+                const TilemapProgram * program = &tilemap_programs[ TL->program ];
+                const LayeredTilemapUniforms * uniforms = &program->layered_uniforms;
+                SetShader( program->layered_shader );
+
+                // Cover whole view with 1 quad; each layer’s scroll is applied per fragment.
+                const float vieww = ortho_view.w - ortho_view.x;
+                const float viewh = ortho_view.h - ortho_view.y;
+                SetVerticesView( ortho_view.x + ( vieww / 2.0f ), ortho_view.y + ( viewh / 2.0f ), 0.0f, 0.0f );
+                mat4 model = BASE_MATRIX;
+                vec3 scale = { vieww, viewh, 0.0 };
+                glm_scale( model, scale );
+                glUniformMatrix4fv( uniforms->model, 1, GL_FALSE, ( float * )( model ) );
+                glUniform2f( uniforms->view_size, vieww, viewh );
+                glUniform2f( uniforms->map_size, ( float )( TL->w ), ( float )( TL->h ) );
+
+                // Set where each layer’s map starts relative to view.
+                float offsets[ NASR_MAX_TILEMAP_LAYERS * 2 ];
+                for ( unsigned int l = 0; l < TL->layer_count; ++l )
+                {
+                    offsets[ l * 2 ] = ortho_view.x - camera.x * TL->scrollx[ l ] - TL->x;
+                    offsets[ l * 2 + 1 ] = ortho_view.y - camera.y * TL->scrolly[ l ] - TL->y;
+                }
+                glUniform1i( uniforms->layer_count, ( GLint )( TL->layer_count ) );
+                glUniform2fv( uniforms->layer_offset, TL->layer_count, offsets );
+                glUniform1fv( uniforms->layer_opacity, TL->layer_count, TL->opacity );
+
+                // Set animation frame table.
+                BindTileAnimations( TL->texture, uniforms->frames, uniforms->animtable );
+
+                // Set tileset texture.
+                TouchTexture( TL->texture );
+                BindTexture( 0, texture_ids[ TL->texture ] );
+                glUniform1i( uniforms->texture, 0 );
+
+                // Set palette texture.
+                BindTexture( 1, palette_texture_id );
+                glUniform1i( uniforms->palette, 1 );
+
+                // Set map layers, uploading any tiles changed since last frame.
+                FlushLayeredTilemap( TL );
+                glActiveTexture( GL_TEXTURE2 );
+                glBindTexture( GL_TEXTURE_2D_ARRAY, TL->maps );
+                glUniform1i( uniforms->mapdata, 2 );
+
+                glUniform1i( uniforms->useglobalpal, TL->useglobalpal ? 1 : 0 );
+                glUniform1ui( uniforms->globalpal, ( GLuint )( global_palette ) );
+
+                SetupVertices( vao );
+
+                #undef TL
+            }
+            break;
             case ( NASR_GRAPHIC_TEXT ):
             {
                 // Set shader.
-                const unsigned int shader = graphics[ i ].data.text.palette_type ? text_pal_shader : text_shader;
-                const TextUniforms * uniforms = graphics[ i ].data.text.palette_type
-                    ? &text_pal_uniforms
-                    : &text_uniforms;
+                unsigned int shader;
+                const TextUniforms * uniforms = GetTextShader( graphics[ i ].data.text.charset, graphics[ i ].data.text.palette_type, &shader );
                 SetShader( shader );
 
                 // Set texture.
-                glActiveTexture( GL_TEXTURE0 );
-                glBindTexture( GL_TEXTURE_2D, charmaps.list[ graphics[ i ].data.text.charset ].texture_id );
+                BindTexture( 0, charmaps.list[ graphics[ i ].data.text.charset ].texture_id );
                 glUniform1i( uniforms->texture, 0 );
 
                 // Set shadow.
                 glUniform1f( uniforms->shadow, graphics[ i ].data.text.shadow );
+                if ( charmaps.list[ graphics[ i ].data.text.charset ].type == NASR_CHARSET_SDF )
+                {
+                    const Texture * texture = &charmaps.list[ graphics[ i ].data.text.charset ].texture;
+                    glUniform2f( uniforms->shadow_offset, 1.0f / ( float )( texture->width ), 1.0f / ( float )( texture->height ) );
+                }
 
                 // Set opacity.
                 glUniform1f( uniforms->opacity, graphics[ i ].data.text.opacity );
@@ -1017,128 +1718,187 @@ void NasrUpdate( float dt )
                     );
                     glUniform1f( uniforms->palette_id, palette );
 
-                    glActiveTexture( GL_TEXTURE1 );
-                    glBindTexture( GL_TEXTURE_2D, palette_texture_id );
+                    BindTexture( 1, palette_texture_id );
                     glUniform1i( uniforms->palette_data, 1 );
                 }
 
                 for ( int j = 0; j < graphics[ i ].data.text.count; ++j )
                 {
-                    #define CHAR graphics[ i ].data.text.chars[ j ]
+                    #define TEXT graphics[ i ].data.text
+                    #define CHAR TEXT.chars[ j ]
                     
                     // Set buffers.
-                    glBindVertexArray( graphics[ i ].data.text.vaos[ j ] );
-                    glBindBuffer( GL_ARRAY_BUFFER, graphics[ i ].data.text.vbos[ j ] );
+                    glBindVertexArray( TEXT.vaos[ j ] );
+                    glBindBuffer( GL_ARRAY_BUFFER, TEXT.vbos[ j ] );
 
-                    // Set view.
+                    // Set view, scaling position from text box origin.
+                    const float w = CHAR.dest.w * TEXT.scale;
+                    const float h = CHAR.dest.h * TEXT.scale;
                     SetVerticesView
                     (
-                        CHAR.dest.x + ( CHAR.dest.w / 2.0f ) + graphics[ i ].data.text.xoffset,
-                        CHAR.dest.y + ( CHAR.dest.h / 2.0f ) + graphics[ i ].data.text.yoffset,
+                        TEXT.originx + ( ( CHAR.dest.x - TEXT.originx ) * TEXT.scale ) + ( w / 2.0f ) + TEXT.xoffset,
+                        TEXT.originy + ( ( CHAR.dest.y - TEXT.originy ) * TEXT.scale ) + ( h / 2.0f ) + TEXT.yoffset,
                         graphics[ i ].scrollx,
                         graphics[ i ].scrolly
                     );
 
                     // Set scale.
                     mat4 model = BASE_MATRIX;
-                    vec3 scale = { CHAR.dest.w, CHAR.dest.h, 0.0 };
+                    vec3 scale = { w, h, 0.0 };
                     glm_scale( model, scale );
                     glUniformMatrix4fv( uniforms->model, 1, GL_FALSE, ( float * )( model ) );
 
-                    SetupVertices( graphics[ i ].data.text.vaos[ j ] );
+                    SetupVertices( TEXT.vaos[ j ] );
                     ClearBufferBindings();
 
                     #undef CHAR
+                    #undef TEXT
                 }
             }
             break;
             case ( NASR_GRAPHIC_COUNTER ):
             {
+                #define COUNTER graphics[ i ].data.counter
+                #define CHARSET charmaps.list[ COUNTER->charset ]
+
                 // Set shader.
-                const unsigned int shader = graphics[ i ].data.counter->palette_type ? text_pal_shader : text_shader;
-                const TextUniforms * uniforms = graphics[ i ].data.counter->palette_type
-                    ? &text_pal_uniforms
-                    : &text_uniforms;
+                unsigned int shader;
+                const CounterUniforms * uniforms = GetCounterShader( COUNTER, &shader );
                 SetShader( shader );
 
                 // Set texture.
-                glActiveTexture( GL_TEXTURE0 );
-                glBindTexture( GL_TEXTURE_2D, charmaps.list[ graphics[ i ].data.counter->charset ].texture_id );
+                BindTexture( 0, CHARSET.texture_id );
                 glUniform1i( uniforms->texture, 0 );
 
                 // Set shadow.
-                glUniform1f( uniforms->shadow, graphics[ i ].data.counter->shadow );
+                glUniform1f( uniforms->shadow, COUNTER->shadow );
+                if ( CHARSET.type == NASR_CHARSET_SDF )
+                {
+                    glUniform2f( uniforms->shadow_offset, 1.0f / ( float )( CHARSET.texture.width ), 1.0f / ( float )( CHARSET.texture.height ) );
+                }
 
                 // Set opacity.
-                glUniform1f( uniforms->opacity, graphics[ i ].data.counter->opacity );
+                glUniform1f( uniforms->opacity, COUNTER->opacity );
 
                 // If using palette, set palette.
-                if ( graphics[ i ].data.counter->palette_type )
+                if ( COUNTER->palette_type )
                 {
                     const float palette = ( float )
                     (
-                        graphics[ i ].data.counter->palette_type == NASR_PALETTE_DEFAULT
+                        COUNTER->palette_type == NASR_PALETTE_DEFAULT
                             ? global_palette
-                            : graphics[ i ].data.counter->palette
+                            : COUNTER->palette
                     );
                     glUniform1f( uniforms->palette_id, palette );
 
-                    glActiveTexture( GL_TEXTURE1 );
-                    glBindTexture( GL_TEXTURE_2D, palette_texture_id );
+                    BindTexture( 1, palette_texture_id );
                     glUniform1i( uniforms->palette_data, 1 );
                 }
 
-                for ( int j = 0; j < graphics[ i ].data.counter->count; ++j )
-                {
-                    #define CHAR graphics[ i ].data.counter->chars[ j ]
-
-                    // Bind buffers.
-                    glBindVertexArray( graphics[ i ].data.counter->vaos[ j ] );
-                    glBindBuffer( GL_ARRAY_BUFFER, graphics[ i ].data.counter->vbos[ j ] );
-
-                    // Set view.
-                    SetVerticesView
-                    (
-                        CHAR.dest.x + ( CHAR.dest.w / 2.0f ) + graphics[ i ].data.counter->xoffset,
-                        CHAR.dest.y + ( CHAR.dest.h / 2.0f ) + graphics[ i ].data.counter->yoffset,
-                        graphics[ i ].scrollx,
-                        graphics[ i ].scrolly
-                    );
+                // Set digit lookup table & digits; shader positions each digit by instance.
+                glUniform4fv( uniforms->digit_src, COUNTER_TABLE_SIZE, CHARSET.numsrc );
+                glUniform4fv( uniforms->digit_dest, COUNTER_TABLE_SIZE, CHARSET.numdest );
+                glUniform1f( uniforms->digit_width, CHARSET.numwidth );
+                glUniform1iv( uniforms->digits, COUNTER->count, COUNTER->digits );
 
-                    // Set scale.
-                    mat4 model = BASE_MATRIX;
-                    vec3 scale = { CHAR.dest.w, CHAR.dest.h, 0.0 };
-                    glm_scale( model, scale );
-                    glUniformMatrix4fv( uniforms->model, 1, GL_FALSE, ( float * )( model ) );
+                // Set view.
+                SetVerticesView
+                (
+                    COUNTER->xoffset,
+                    COUNTER->yoffset,
+                    graphics[ i ].scrollx,
+                    graphics[ i ].scrolly
+                );
 
-                    SetupVertices( graphics[ i ].data.counter->vaos[ j ] );
-                    ClearBufferBindings();
+                glBindVertexArray( COUNTER->vao );
+                glBindBuffer( GL_ARRAY_BUFFER, COUNTER->vbo );
+                glDrawElementsInstanced( GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, COUNTER->count );
 
-                    #undef CHAR
-                }
+                #undef COUNTER
+                #undef CHARSET
             }
             break;
-            default:
+            case ( NASR_GRAPHIC_TEXT_STREAM ):
             {
-                NasrLog( "¡Trying to render invalid graphic type #%d!\n", graphics[ i ].type );
-            }
-            break;
-        }
-        ClearBufferBindings();
-    }
+                #define STREAM graphics[ i ].data.stream
 
-    glfwSwapBuffers( window );
-    prev_camera = camera;
+                // Set shader.
+                unsigned int shader;
+                const TextUniforms * uniforms = GetTextShader( STREAM->charset, STREAM->palette_type, &shader );
+                SetShader( shader );
 
-    animation_timer += dt;
-    if ( animation_timer >= animation_ticks_per_frame )
-    {
-        animation_timer -= animation_ticks_per_frame;
-        ++animation_frame;
-        if ( animation_frame == MAX_ANIMATION_FRAME )
-        {
-            animation_frame = 0;
+                // Set texture.
+                BindTexture( 0, charmaps.list[ STREAM->charset ].texture_id );
+                glUniform1i( uniforms->texture, 0 );
+
+                // Set shadow.
+                glUniform1f( uniforms->shadow, STREAM->shadow );
+                if ( charmaps.list[ STREAM->charset ].type == NASR_CHARSET_SDF )
+                {
+                    const Texture * texture = &charmaps.list[ STREAM->charset ].texture;
+                    glUniform2f( uniforms->shadow_offset, 1.0f / ( float )( texture->width ), 1.0f / ( float )( texture->height ) );
+                }
+
+                // Set opacity.
+                glUniform1f( uniforms->opacity, STREAM->opacity );
+
+                // If using palette, set palette.
+                if ( STREAM->palette_type )
+                {
+                    const float palette = ( float )
+                    (
+                        STREAM->palette_type == NASR_PALETTE_DEFAULT
+                            ? global_palette
+                            : STREAM->palette
+                    );
+                    glUniform1f( uniforms->palette_id, palette );
+
+                    BindTexture( 1, palette_texture_id );
+                    glUniform1i( uniforms->palette_data, 1 );
+                }
+
+                // Glyph positions are already in pixels, so only scroll needs to be applied.
+                mat4 model = BASE_MATRIX;
+                glUniformMatrix4fv( uniforms->model, 1, GL_FALSE, ( float * )( model ) );
+                SetVerticesView
+                (
+                    STREAM->xoffset,
+                    STREAM->yoffset - STREAM->scroll,
+                    graphics[ i ].scrollx,
+                    graphics[ i ].scrolly
+                );
+
+                glBindVertexArray( STREAM->vao );
+                glBindBuffer( GL_ARRAY_BUFFER, STREAM->vbo );
+                DrawTextStream( STREAM );
+
+                #undef STREAM
+            }
+            break;
+            default:
+            {
+                NasrLog( "¡Trying to render invalid graphic type #%d!\n", graphics[ i ].type );
+            }
+            break;
+        }
+        ClearBufferBindings();
+    }
+
+    glfwSwapBuffers( window );
+    prev_camera = camera;
+    EvictTextures();
+
+    animation_timer += dt;
+    if ( animation_timer >= animation_ticks_per_frame )
+    {
+        animation_timer -= animation_ticks_per_frame;
+        ++animation_frame;
+        ++animation_clock;
+        if ( animation_frame == MAX_ANIMATION_FRAME )
+        {
+            animation_frame = 0;
         }
+        UpdateAnimationFrames();
     }
 };
 
@@ -1198,9 +1958,12 @@ void NasrSetPalette( const char * filename )
 {
     unsigned int width;
     unsigned int height;
-    unsigned char * data = LoadTextureFileData( filename, &width, &height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO );
-    AddTexture( &palette_texture, palette_texture_id, data, width, height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO );
+    unsigned char * data = LoadTextureFileData( filename, &width, &height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO, IsTextureFile( filename ) );
+    AddTexture( &palette_texture, palette_texture_id, data, width, height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO, 4 );
     free( data );
+
+    // Baked tilemaps hold palette colors, so they need rebaking.
+    ++palette_version;
 };
 
 void NasrSetGlobalPalette( uint_fast8_t palette )
@@ -1212,6 +1975,11 @@ void NasrSetGlobalPalette( uint_fast8_t palette )
 
 // Charset
 int NasrAddCharset( const char * texture, const char * chardata )
+{
+    return NasrAddCharsetEx( texture, chardata, NASR_CHARSET_BITMAP );
+};
+
+int NasrAddCharsetEx( const char * texture, const char * chardata, int type )
 {
     char * text = NasrReadFile( chardata );
     if ( !text )
@@ -1392,10 +2160,30 @@ int NasrAddCharset( const char * texture, const char * chardata )
 
             unsigned int width;
             unsigned int height;
-            unsigned char * data = LoadTextureFileData( texture, &width, &height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO );
+            unsigned char * data = LoadTextureFileData( texture, &width, &height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO, IsTextureFile( texture ) );
             glGenTextures( 1, &charmaps.list[ id ].texture_id );
-            AddTexture( &charmaps.list[ id ].texture, charmaps.list[ id ].texture_id, data, width, height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO );
+
+            // Distance field charsets are converted once here & sampled linearly so they stay sharp when scaled.
+            charmaps.list[ id ].type = type == NASR_CHARSET_SDF ? NASR_CHARSET_SDF : NASR_CHARSET_BITMAP;
+            if ( charmaps.list[ id ].type == NASR_CHARSET_SDF && data )
+            {
+                GenerateDistanceField( data, width, height );
+            }
+            AddTexture
+            (
+                &charmaps.list[ id ].texture,
+                charmaps.list[ id ].texture_id,
+                data,
+                width,
+                height,
+                charmaps.list[ id ].type == NASR_CHARSET_SDF ? NASR_SAMPLING_LINEAR : NASR_SAMPLING_NEAREST,
+                NASR_INDEXED_NO,
+                4
+            );
             free( data );
+            charmaps.list[ id ].image = charmaps.list[ id ].texture;
+            charmaps.list[ id ].atlasy = 0.0f;
+            charmaps.list[ id ].packed = 0;
 
             // Autogenerate newline & whitespace characters.
             CharMapEntry * entry = CharMapGenEntry( ( unsigned int )( id ), "\n" );
@@ -1441,6 +2229,7 @@ int NasrAddCharset( const char * texture, const char * chardata )
                 charmaps.list[ id ].nums[ i ].xoffset = ( charmaps.list[ id ].numwidth - charmaps.list[ id ].nums[ i ].src.w ) / 2.0f;
                 charmaps.list[ id ].nums[ i ].yoffset = ( charmaps.list[ id ].numheight - charmaps.list[ id ].nums[ i ].src.h ) / 2.0f;
             }
+            GenerateCharsetDigitTable( ( unsigned int )( id ) );
         }
     }
 
@@ -1464,12 +2253,200 @@ void NasrRemoveCharset( unsigned int charset )
                 free( charmaps.list[ charset ].list[ j ].key.string );
             }
         }
-        glDeleteTextures( 1, &charmaps.list[ charset ].texture_id );
+        // Packed charsets share the atlas, which is only deleted on close.
+        if ( !charmaps.list[ charset ].packed )
+        {
+            glDeleteTextures( 1, &charmaps.list[ charset ].texture_id );
+        }
         free( charmaps.list[ charset ].list );
         charmaps.list[ charset ].list = 0;
     }
 };
 
+int NasrPackCharsets( void )
+{
+    // Stack all charset images o’ each other in 1 atlas so all text can share 1 texture.
+    // Distance field charsets are left out, since they need linear sampling & their own shaders.
+    unsigned int width = 0;
+    unsigned int height = 0;
+    for ( int i = 0; i < charmaps.capacity; ++i )
+    {
+        if ( charmaps.list[ i ].list && charmaps.list[ i ].type != NASR_CHARSET_SDF )
+        {
+            width = NASR_MATH_MAX( width, charmaps.list[ i ].image.width );
+            height += charmaps.list[ i ].image.height;
+        }
+    }
+
+    if ( !width || !height )
+    {
+        NasrLog( "NasrPackCharsets Error: no charsets to pack." );
+        return -1;
+    }
+
+    GLint max_size;
+    glGetIntegerv( GL_MAX_TEXTURE_SIZE, &max_size );
+    if ( width > max_size || height > max_size )
+    {
+        NasrLog( "NasrPackCharsets Error: atlas o’ %ux%u is bigger than max texture size %d.", width, height, max_size );
+        return -1;
+    }
+
+    unsigned char * atlas = calloc( width * height * 4, sizeof( unsigned char ) );
+    if ( !atlas )
+    {
+        NasrLog( "NasrPackCharsets Error: ¡Not ’nough memory for charset atlas!" );
+        return -1;
+    }
+
+    // If charsets were already packed, read back ol’ atlas once so we can pull their images out o’ it.
+    unsigned char * prev_atlas = 0;
+    if ( charset_atlas_id )
+    {
+        prev_atlas = malloc( charset_atlas.width * charset_atlas.height * 4 );
+        if ( !prev_atlas )
+        {
+            free( atlas );
+            NasrLog( "NasrPackCharsets Error: ¡Not ’nough memory for charset atlas!" );
+            return -1;
+        }
+        glBindTexture( GL_TEXTURE_2D, charset_atlas_id );
+        glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, prev_atlas );
+    }
+
+    float * offsets = calloc( charmaps.capacity, sizeof( float ) );
+    if ( !offsets )
+    {
+        free( atlas );
+        free( prev_atlas );
+        NasrLog( "NasrPackCharsets Error: ¡Not ’nough memory for charset atlas!" );
+        return -1;
+    }
+
+    // Charsets aren’t touched till every image is copied, so running out o’ memory partway leaves them all as they were.
+    unsigned int y = 0;
+    for ( int i = 0; i < charmaps.capacity; ++i )
+    {
+        #define CM charmaps.list[ i ]
+
+        offsets[ i ] = 0.0f;
+        if ( !CM.list || CM.type == NASR_CHARSET_SDF )
+        {
+            continue;
+        }
+
+        const size_t rowsize = CM.image.width * 4;
+        unsigned char * pixels = prev_atlas;
+        size_t srcy = ( size_t )( CM.atlasy );
+        size_t srcw = charset_atlas.width;
+        if ( !CM.packed )
+        {
+            pixels = malloc( rowsize * CM.image.height );
+            if ( !pixels )
+            {
+                free( atlas );
+                free( prev_atlas );
+                free( offsets );
+                NasrLog( "NasrPackCharsets Error: ¡Not ’nough memory for charset atlas!" );
+                return -1;
+            }
+            glBindTexture( GL_TEXTURE_2D, CM.texture_id );
+            glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels );
+            srcy = 0;
+            srcw = CM.image.width;
+        }
+
+        for ( unsigned int row = 0; row < CM.image.height; ++row )
+        {
+            memcpy( &atlas[ ( y + row ) * width * 4 ], &pixels[ ( srcy + row ) * srcw * 4 ], rowsize );
+        }
+
+        if ( !CM.packed )
+        {
+            free( pixels );
+        }
+
+        offsets[ i ] = ( float )( y ) - CM.atlasy;
+        y += CM.image.height;
+
+        #undef CM
+    }
+    free( prev_atlas );
+
+    if ( charset_atlas_id )
+    {
+        glDeleteTextures( 1, &charset_atlas_id );
+    }
+    glGenTextures( 1, &charset_atlas_id );
+    AddTexture( &charset_atlas, charset_atlas_id, atlas, width, height, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO, 4 );
+    free( atlas );
+
+    // Rebase glyphs into atlas.
+    for ( int i = 0; i < charmaps.capacity; ++i )
+    {
+        #define CM charmaps.list[ i ]
+
+        if ( !CM.list || CM.type == NASR_CHARSET_SDF )
+        {
+            continue;
+        }
+
+        for ( int j = 0; j < CM.capacity; ++j )
+        {
+            if ( CM.list[ j ].key.string )
+            {
+                CM.list[ j ].value.src.y += offsets[ i ];
+            }
+        }
+        for ( int j = 0; j < 11; ++j )
+        {
+            CM.nums[ j ].src.y += offsets[ i ];
+        }
+        if ( !CM.packed )
+        {
+            glDeleteTextures( 1, &CM.texture_id );
+        }
+        CM.atlasy += offsets[ i ];
+        CM.texture_id = charset_atlas_id;
+        CM.texture = charset_atlas;
+        CM.packed = 1;
+        GenerateCharsetDigitTable( i );
+
+        #undef CM
+    }
+
+    // Update texture coords o’ text already made.
+    for ( int i = 0; i < num_o_graphics; ++i )
+    {
+        if ( graphics[ i ].type == NASR_GRAPHIC_TEXT && charmaps.list[ graphics[ i ].data.text.charset ].type != NASR_CHARSET_SDF )
+        {
+            #define TEXT graphics[ i ].data.text
+            for ( int j = 0; j < TEXT.capacity; ++j )
+            {
+                float * vptr = &TEXT.vertices[ j * VERTEX_RECT_SIZE ];
+                TEXT.chars[ j ].src.y += offsets[ TEXT.charset ];
+                UpdateCharVertices( vptr, &TEXT.chars[ j ].src, &charset_atlas );
+                glBindVertexArray( TEXT.vaos[ j ] );
+                glBindBuffer( GL_ARRAY_BUFFER, TEXT.vbos[ j ] );
+                BufferVertices( vptr );
+            }
+            #undef TEXT
+        }
+        else if ( graphics[ i ].type == NASR_GRAPHIC_TEXT_STREAM && charmaps.list[ graphics[ i ].data.stream->charset ].type != NASR_CHARSET_SDF )
+        {
+            // Streamed lines get laid out ’gain with new coords as they’re drawn.
+            for ( unsigned int j = 0; j < graphics[ i ].data.stream->window_lines; ++j )
+            {
+                graphics[ i ].data.stream->slot_lines[ j ] = -1;
+            }
+        }
+    }
+    ClearBufferBindings();
+    free( offsets );
+
+    return 0;
+};
+
 
 
 // Time
@@ -2115,6 +3092,59 @@ int NasrGraphicsAddTilemap
     float tilingy
 )
 {
+    return NasrGraphicsAddTilemapEx
+    (
+        scrollx,
+        scrolly,
+        state,
+        layer,
+        texture,
+        tiles,
+        w,
+        h,
+        useglobalpal,
+        opacity,
+        tilingx,
+        tilingy,
+        16,
+        16
+    );
+};
+
+int NasrGraphicsAddTilemapEx
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    unsigned int texture,
+    const NasrTile * tiles,
+    unsigned int w,
+    unsigned int h,
+    int_fast8_t useglobalpal,
+    float opacity,
+    float tilingx,
+    float tilingy,
+    unsigned int tilew,
+    unsigned int tileh
+)
+{
+    if ( tilew == 0 || tileh == 0 )
+    {
+        NasrLog( "NasrGraphicsAddTilemapEx Error: invalid tile size %ux%u.", tilew, tileh );
+        return -1;
+    }
+    if ( CheckTextureUnpacked( "NasrGraphicsAddTilemapEx", texture ) != 0 )
+    {
+        return -1;
+    }
+
+    const int program = GetTilemapProgram( tilew, tileh );
+    if ( program < 0 )
+    {
+        return -1;
+    }
+
     // Generate texture from tile data.
     unsigned char * data = ( unsigned char * )( calloc( w * h * 4, sizeof( unsigned char ) ) );
     if ( data == NULL )
@@ -2131,13 +3161,17 @@ int NasrGraphicsAddTilemap
         data[ i4 + 3 ] = tiles[ i ].animation;
         i4 += 4;
     }
-    const int tilemap_texture = NasrAddTextureEx( data, w, h, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO );
+    const int tilemap_texture = NasrAddTextureEx( 0, w, h, NASR_SAMPLING_NEAREST, NASR_INDEXED_NO );
 
     if ( tilemap_texture < 0 )
     {
         free( data );
         return -1;
     }
+    SetTilemapTextureData( texture_ids[ tilemap_texture ], data, w, h );
+
+    // Map texture belongs to tilemap, so clearing textures mustn’t touch it.
+    textures[ tilemap_texture ].owned = 1;
 
     struct NasrGraphic graphic;
     graphic.scrollx = scrollx;
@@ -2151,15 +3185,39 @@ int NasrGraphicsAddTilemap
     graphic.data.tilemap.src.h = ( float )( h );
     graphic.data.tilemap.dest.x = 0.0f;
     graphic.data.tilemap.dest.y = 0.0f;
-    graphic.data.tilemap.dest.w = ( float )( w ) * 16.0f;
-    graphic.data.tilemap.dest.h = ( float )( h ) * 16.0f;
+    graphic.data.tilemap.dest.w = ( float )( w * tilew );
+    graphic.data.tilemap.dest.h = ( float )( h * tileh );
     graphic.data.tilemap.useglobalpal = useglobalpal;
     graphic.data.tilemap.opacity = opacity;
     graphic.data.tilemap.data = data;
     graphic.data.tilemap.tilingx = tilingx;
     graphic.data.tilemap.tilingy = tilingy;
+    graphic.data.tilemap.tilew = tilew;
+    graphic.data.tilemap.tileh = tileh;
+    graphic.data.tilemap.program = ( unsigned int )( program );
+    graphic.data.tilemap.dirty_count = 0;
+    graphic.data.tilemap.bake = 0;
+    graphic.data.tilemap.bake_textures = 0;
+    graphic.data.tilemap.bake_stale = 0;
+
+    // Build collision bitset & per-row solid counts from tile data so queries needn’t touch texels.
+    graphic.data.tilemap.solid_stride = ( w + 63 ) / 64;
+    graphic.data.tilemap.solid = ( uint64_t * )( calloc( ( size_t )( graphic.data.tilemap.solid_stride ) * h, sizeof( uint64_t ) ) );
+    graphic.data.tilemap.solid_rows = ( unsigned int * )( calloc( h, sizeof( unsigned int ) ) );
+    if ( graphic.data.tilemap.solid == NULL || graphic.data.tilemap.solid_rows == NULL )
+    {
+        NasrLog( "Couldn’t generate tilemap collision data." );
+        DestroyGraphic( &graphic );
+        return -1;
+    }
+    UpdateTilemapSolidity( &graphic.data.tilemap, 0, 0, w, h );
+
     const int id = AddGraphic( state, layer, graphic );
-    if ( id > -1 )
+    if ( id < 0 )
+    {
+        DestroyGraphic( &graphic );
+    }
+    else
     {
         BindBuffers( id );
         float * vptr = GetVertices( id );
@@ -2174,67 +3232,303 @@ int NasrGraphicsAddTilemap
     return id;
 }
 
-int NasrGraphicsAddText
+int NasrGraphicsAddChunkedTilemap
 (
     float scrollx,
 	float scrolly,
     unsigned int state,
     unsigned int layer,
-    NasrText text,
-    NasrColor color
+    unsigned int texture,
+    const NasrTile * tiles,
+    unsigned int w,
+    unsigned int h,
+    int_fast8_t useglobalpal,
+    float opacity
 )
 {
-    return GraphicAddText
-    (
-        scrollx,
-        scrolly,
-        state,
-        layer,
-        text,
-        &color,
-        &color,
-        &color,
-        &color,
-        0,
-        NASR_PALETTE_NONE
-    );
-};
+    if ( CheckTextureUnpacked( "NasrGraphicsAddChunkedTilemap", texture ) != 0 )
+    {
+        return -1;
+    }
 
-int NasrGraphicsAddTextGradient
-(
-    float scrollx,
-	float scrolly,
-    unsigned int state,
-    unsigned int layer,
-    NasrText text,
-    int_fast8_t dir,
-    NasrColor color1,
-    NasrColor color2
-)
-{
-    NasrColor top_left_color;
-    NasrColor top_right_color;
-    NasrColor bottom_left_color;
-    NasrColor bottom_right_color;
-    switch ( dir )
+    NasrGraphicChunkedTilemap * tilemap = calloc( 1, sizeof( NasrGraphicChunkedTilemap ) );
+    if ( !tilemap )
     {
-        case ( NASR_DIR_UP ):
-        {
-            top_left_color = color2;
-            top_right_color = color2;
-            bottom_left_color = color1;
-            bottom_right_color = color1;
-        }
-        break;
-        case ( NASR_DIR_UPRIGHT ):
-        {
-            top_left_color = color1;
-            top_right_color = color2;
-            bottom_left_color = color1;
-            bottom_right_color = color1;
-        }
-        break;
-        case ( NASR_DIR_RIGHT ):
+        NasrLog( "NasrGraphicsAddChunkedTilemap Error: ¡Not ’nough memory for tilemap!" );
+        return -1;
+    }
+    tilemap->texture = texture;
+    tilemap->w = w;
+    tilemap->h = h;
+    tilemap->chunksw = ( w + TILEMAP_CHUNK_SIZE - 1 ) / TILEMAP_CHUNK_SIZE;
+    tilemap->chunksh = ( h + TILEMAP_CHUNK_SIZE - 1 ) / TILEMAP_CHUNK_SIZE;
+    tilemap->useglobalpal = useglobalpal;
+    tilemap->opacity = opacity;
+
+    // Enough slots for every chunk that can touch screen plus 1 chunk o’ margin all round.
+    const unsigned int slotsw = ( unsigned int )( ceilf( canvas.w / TILEMAP_CHUNK_PIXELS ) ) + 3;
+    const unsigned int slotsh = ( unsigned int )( ceilf( canvas.h / TILEMAP_CHUNK_PIXELS ) ) + 3;
+    const size_t chunk_count = ( size_t )( tilemap->chunksw ) * tilemap->chunksh;
+    tilemap->slot_count = slotsw * slotsh;
+    tilemap->chunks = calloc( chunk_count, sizeof( unsigned char * ) );
+    tilemap->chunk_slots = malloc( chunk_count * sizeof( int ) );
+    tilemap->slot_textures = calloc( tilemap->slot_count, sizeof( GLuint ) );
+    tilemap->slot_chunks = malloc( tilemap->slot_count * sizeof( int ) );
+    tilemap->slot_used = calloc( tilemap->slot_count, sizeof( unsigned int ) );
+    tilemap->slot_dirty = calloc( tilemap->slot_count, sizeof( uint_fast8_t ) );
+    if ( !tilemap->chunks || !tilemap->chunk_slots || !tilemap->slot_textures || !tilemap->slot_chunks || !tilemap->slot_used || !tilemap->slot_dirty )
+    {
+        NasrLog( "NasrGraphicsAddChunkedTilemap Error: ¡Not ’nough memory for tilemap!" );
+        DestroyChunkedTilemap( tilemap );
+        return -1;
+    }
+    for ( size_t i = 0; i < chunk_count; ++i )
+    {
+        tilemap->chunk_slots[ i ] = -1;
+    }
+    for ( unsigned int i = 0; i < tilemap->slot_count; ++i )
+    {
+        tilemap->slot_chunks[ i ] = -1;
+    }
+
+    // Copy tiles into chunk-major data, leaving chunks with nothing visible unallocated.
+    if ( tiles )
+    {
+        for ( unsigned int cy = 0; cy < tilemap->chunksh; ++cy )
+        {
+            for ( unsigned int cx = 0; cx < tilemap->chunksw; ++cx )
+            {
+                const unsigned int tw = NASR_MATH_MIN( TILEMAP_CHUNK_SIZE, w - cx * TILEMAP_CHUNK_SIZE );
+                const unsigned int th = NASR_MATH_MIN( TILEMAP_CHUNK_SIZE, h - cy * TILEMAP_CHUNK_SIZE );
+                const NasrTile * src = &tiles[ ( size_t )( cy ) * TILEMAP_CHUNK_SIZE * w + cx * TILEMAP_CHUNK_SIZE ];
+                uint_fast8_t empty = 1;
+                for ( unsigned int y = 0; y < th && empty; ++y )
+                {
+                    for ( unsigned int x = 0; x < tw; ++x )
+                    {
+                        if ( src[ ( size_t )( y ) * w + x ].animation != 255 )
+                        {
+                            empty = 0;
+                            break;
+                        }
+                    }
+                }
+                if ( empty )
+                {
+                    continue;
+                }
+
+                unsigned char * chunk = GetTilemapChunk( tilemap, cy * tilemap->chunksw + cx );
+                if ( !chunk )
+                {
+                    NasrLog( "NasrGraphicsAddChunkedTilemap Error: ¡Not ’nough memory for tilemap!" );
+                    DestroyChunkedTilemap( tilemap );
+                    return -1;
+                }
+                for ( unsigned int y = 0; y < th; ++y )
+                {
+                    memcpy( &chunk[ y * TILEMAP_CHUNK_SIZE * 4 ], &src[ ( size_t )( y ) * w ], tw * sizeof( NasrTile ) );
+                }
+            }
+        }
+    }
+
+    glGenTextures( tilemap->slot_count, tilemap->slot_textures );
+    for ( unsigned int i = 0; i < tilemap->slot_count; ++i )
+    {
+        SetTilemapTextureData( tilemap->slot_textures[ i ], 0, TILEMAP_CHUNK_SIZE, TILEMAP_CHUNK_SIZE );
+    }
+
+    struct NasrGraphic graphic;
+    graphic.scrollx = scrollx;
+    graphic.scrolly = scrolly;
+    graphic.type = NASR_GRAPHIC_TILEMAP_CHUNKED;
+    graphic.data.chunked = tilemap;
+    const int id = AddGraphic( state, layer, graphic );
+    if ( id < 0 )
+    {
+        DestroyChunkedTilemap( tilemap );
+        return -1;
+    }
+
+    // Every chunk is drawn as full quad o’ its slot texture.
+    BindBuffers( id );
+    float * vptr = GetVertices( id );
+    ResetVertices( vptr );
+    BufferVertices( vptr );
+    ClearBufferBindings();
+    return id;
+};
+
+int NasrGraphicsAddLayeredTilemap
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    unsigned int texture,
+    const NasrTile * const * tiles,
+    unsigned int layer_count,
+    unsigned int w,
+    unsigned int h,
+    unsigned int tilew,
+    unsigned int tileh,
+    int_fast8_t useglobalpal,
+    float opacity
+)
+{
+    if ( layer_count == 0 || layer_count > NASR_MAX_TILEMAP_LAYERS )
+    {
+        NasrLog( "NasrGraphicsAddLayeredTilemap Error: layer count %u must be from 1 to %d.", layer_count, NASR_MAX_TILEMAP_LAYERS );
+        return -1;
+    }
+    if ( tilew == 0 || tileh == 0 )
+    {
+        NasrLog( "NasrGraphicsAddLayeredTilemap Error: invalid tile size %ux%u.", tilew, tileh );
+        return -1;
+    }
+    if ( CheckTextureUnpacked( "NasrGraphicsAddLayeredTilemap", texture ) != 0 )
+    {
+        return -1;
+    }
+
+    const int program = GetTilemapProgram( tilew, tileh );
+    if ( program < 0 )
+    {
+        return -1;
+    }
+
+    NasrGraphicLayeredTilemap * tilemap = calloc( 1, sizeof( NasrGraphicLayeredTilemap ) );
+    const size_t layer_size = ( size_t )( w ) * h * 4;
+    unsigned char * data = malloc( layer_size * layer_count );
+    if ( !tilemap || !data )
+    {
+        NasrLog( "NasrGraphicsAddLayeredTilemap Error: ¡Not ’nough memory for tilemap!" );
+        free( tilemap );
+        free( data );
+        return -1;
+    }
+
+    // NasrTile has same layout as map texels; layers without tiles start empty.
+    for ( unsigned int l = 0; l < layer_count; ++l )
+    {
+        if ( tiles && tiles[ l ] )
+        {
+            memcpy( &data[ layer_size * l ], tiles[ l ], layer_size );
+        }
+        else
+        {
+            const NasrTile empty = { 0, 0, 0, 255 };
+            for ( size_t t = 0; t < ( size_t )( w ) * h; ++t )
+            {
+                memcpy( &data[ layer_size * l + t * 4 ], &empty, sizeof( NasrTile ) );
+            }
+        }
+        tilemap->scrollx[ l ] = scrollx;
+        tilemap->scrolly[ l ] = scrolly;
+        tilemap->opacity[ l ] = opacity;
+    }
+    tilemap->texture = texture;
+    tilemap->w = w;
+    tilemap->h = h;
+    tilemap->layer_count = layer_count;
+    tilemap->tilew = tilew;
+    tilemap->tileh = tileh;
+    tilemap->program = ( unsigned int )( program );
+    tilemap->data = data;
+    tilemap->useglobalpal = useglobalpal;
+
+    // All layers live in 1 array texture so whole stack needs only 1 map binding.
+    glGenTextures( 1, &tilemap->maps );
+    glActiveTexture( GL_TEXTURE2 );
+    glBindTexture( GL_TEXTURE_2D_ARRAY, tilemap->maps );
+    glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+    glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+    glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+    glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+    glTexImage3D( GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8UI, w, h, layer_count, 0, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, data );
+
+    struct NasrGraphic graphic;
+    graphic.scrollx = scrollx;
+    graphic.scrolly = scrolly;
+    graphic.type = NASR_GRAPHIC_TILEMAP_LAYERED;
+    graphic.data.layered = tilemap;
+    const int id = AddGraphic( state, layer, graphic );
+    if ( id < 0 )
+    {
+        DestroyGraphic( &graphic );
+        return -1;
+    }
+
+    BindBuffers( id );
+    float * vptr = GetVertices( id );
+    ResetVertices( vptr );
+    BufferVertices( vptr );
+    ClearBufferBindings();
+    return id;
+};
+
+int NasrGraphicsAddText
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    NasrColor color
+)
+{
+    return GraphicAddText
+    (
+        scrollx,
+        scrolly,
+        state,
+        layer,
+        text,
+        &color,
+        &color,
+        &color,
+        &color,
+        0,
+        NASR_PALETTE_NONE
+    );
+};
+
+int NasrGraphicsAddTextGradient
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    int_fast8_t dir,
+    NasrColor color1,
+    NasrColor color2
+)
+{
+    NasrColor top_left_color;
+    NasrColor top_right_color;
+    NasrColor bottom_left_color;
+    NasrColor bottom_right_color;
+    switch ( dir )
+    {
+        case ( NASR_DIR_UP ):
+        {
+            top_left_color = color2;
+            top_right_color = color2;
+            bottom_left_color = color1;
+            bottom_right_color = color1;
+        }
+        break;
+        case ( NASR_DIR_UPRIGHT ):
+        {
+            top_left_color = color1;
+            top_right_color = color2;
+            bottom_left_color = color1;
+            bottom_right_color = color1;
+        }
+        break;
+        case ( NASR_DIR_RIGHT ):
         {
             top_left_color = color1;
             top_right_color = color2;
@@ -2463,6 +3757,61 @@ int NasrGraphicsAddTextGradientPalette
     );
 };
 
+int NasrGraphicsAddTextStream
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    NasrColor color
+)
+{
+    return GraphicAddTextStream
+    (
+        scrollx,
+        scrolly,
+        state,
+        layer,
+        text,
+        color,
+        0,
+        NASR_PALETTE_NONE
+    );
+};
+
+int NasrGraphicsAddTextStreamPalette
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    uint_fast8_t palette,
+    uint_fast8_t useglobalpal,
+    uint_fast8_t color
+)
+{
+    NasrColor c =
+    {
+        ( float )( color ),
+        0.0f,
+        0.0f,
+        255.0f
+    };
+    return GraphicAddTextStream
+    (
+        scrollx,
+        scrolly,
+        state,
+        layer,
+        text,
+        c,
+        palette,
+        useglobalpal ? NASR_PALETTE_DEFAULT : NASR_PALETTE_SET
+    );
+};
+
 int NasrGraphicsAddCounter
 (
     float scrollx,
@@ -5061,10 +6410,7 @@ void NasrGraphicsTilemapSetTileX( unsigned int id, unsigned int x, unsigned int
     NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
     const unsigned int i = ( y * TEX.width + x ) * 4;
     t->data[ i ] = v;
-
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ t->tilemap ] );
-    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TEX.width, TEX.height, GL_RGBA, GL_UNSIGNED_BYTE, t->data );
-    ClearBufferBindings();
+    MarkTilemapDirty( t, x, y, 1, 1 );
 
     #undef TEX
 };
@@ -5083,10 +6429,7 @@ void NasrGraphicsTilemapSetTileY( unsigned int id, unsigned int x, unsigned int
     NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
     const unsigned int i = ( ( y * TEX.width + x ) * 4 ) + 1;
     t->data[ i ] = v;
-
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ t->tilemap ] );
-    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TEX.width, TEX.height, GL_RGBA, GL_UNSIGNED_BYTE, t->data );
-    ClearBufferBindings();
+    MarkTilemapDirty( t, x, y, 1, 1 );
 
     #undef TEX
 };
@@ -5105,10 +6448,7 @@ void NasrGraphicsTilemapSetTilePalette( unsigned int id, unsigned int x, unsigne
     NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
     const unsigned int i = ( ( y * TEX.width + x ) * 4 ) + 2;
     t->data[ i ] = v;
-
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ t->tilemap ] );
-    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TEX.width, TEX.height, GL_RGBA, GL_UNSIGNED_BYTE, t->data );
-    ClearBufferBindings();
+    MarkTilemapDirty( t, x, y, 1, 1 );
 
     #undef TEX
 };
@@ -5127,10 +6467,7 @@ void NasrGraphicsTilemapSetTileAnimation( unsigned int id, unsigned int x, unsig
     NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
     const unsigned int i = ( ( y * TEX.width + x ) * 4 ) + 3;
     t->data[ i ] = v;
-
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ t->tilemap ] );
-    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TEX.width, TEX.height, GL_RGBA, GL_UNSIGNED_BYTE, t->data );
-    ClearBufferBindings();
+    MarkTilemapDirty( t, x, y, 1, 1 );
 
     #undef TEX
 };
@@ -5152,10 +6489,7 @@ void NasrGraphicsTilemapSetTile( unsigned int id, unsigned int x, unsigned int y
     t->data[ i + 1 ] = tile.y;
     t->data[ i + 2 ] = tile.palette;
     t->data[ i + 3 ] = tile.animation;
-
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ t->tilemap ] );
-    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TEX.width, TEX.height, GL_RGBA, GL_UNSIGNED_BYTE, t->data );
-    ClearBufferBindings();
+    MarkTilemapDirty( t, x, y, 1, 1 );
 
     #undef TEX
 };
@@ -5174,1754 +6508,5143 @@ void NasrGraphicsTilemapClearTile( unsigned int id, unsigned int x, unsigned int
     NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
     const unsigned int i = ( ( y * TEX.width + x ) * 4 ) + 3;
     t->data[ i ] = 255;
-
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ t->tilemap ] );
-    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TEX.width, TEX.height, GL_RGBA, GL_UNSIGNED_BYTE, t->data );
-    ClearBufferBindings();
+    MarkTilemapDirty( t, x, y, 1, 1 );
 
     #undef TEX
 };
 
-float NasrGraphicsTilemapGetOpacity( unsigned int id )
+void NasrGraphicsTilemapSetTiles( unsigned int id, NasrRectInt region, const NasrTile * tiles, unsigned int stride )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTilemapGetOpacity Error: invalid id %u", id );
-            return 0.0f;
+            NasrLog( "NasrGraphicsTilemapSetTiles Error: invalid id %u", id );
+            return;
+        }
+        if ( tiles == NULL )
+        {
+            NasrLog( "NasrGraphicsTilemapSetTiles Error: null tiles given for tilemap %u", id );
+            return;
         }
     #endif
 
+    #define TEX textures[ t->tilemap ]
     NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
-    return t->opacity;
+
+    // Clip region to map, keeping track o’ where clipped region starts in source tiles.
+    const int x = NASR_MATH_MAX( region.x, 0 );
+    const int y = NASR_MATH_MAX( region.y, 0 );
+    const int w = NASR_MATH_MIN( region.x + region.w, ( int )( TEX.width ) ) - x;
+    const int h = NASR_MATH_MIN( region.y + region.h, ( int )( TEX.height ) ) - y;
+    if ( w <= 0 || h <= 0 )
+    {
+        return;
+    }
+    const NasrTile * src = &tiles[ ( size_t )( y - region.y ) * stride + ( x - region.x ) ];
+
+    // NasrTile has same layout as map texels, so each row is just copied straight o’er.
+    for ( int row = 0; row < h; ++row )
+    {
+        memcpy( &t->data[ ( ( size_t )( y + row ) * TEX.width + x ) * 4 ], &src[ ( size_t )( row ) * stride ], w * sizeof( NasrTile ) );
+    }
+    MarkTilemapDirty( t, x, y, w, h );
+
+    #undef TEX
 };
 
-void NasrGraphicsTilemapSetOpacity( unsigned int id, float opacity )
+void NasrGraphicsTilemapFill( unsigned int id, NasrRectInt region, NasrTile tile )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTilemapSetOpacity Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsTilemapFill Error: invalid id %u", id );
             return;
         }
     #endif
 
+    #define TEX textures[ t->tilemap ]
     NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
-    t->opacity = opacity;
-};
 
+    const int x = NASR_MATH_MAX( region.x, 0 );
+    const int y = NASR_MATH_MAX( region.y, 0 );
+    const int w = NASR_MATH_MIN( region.x + region.w, ( int )( TEX.width ) ) - x;
+    const int h = NASR_MATH_MIN( region.y + region.h, ( int )( TEX.height ) ) - y;
+    if ( w <= 0 || h <= 0 )
+    {
+        return;
+    }
 
+    // Fill 1st row, then copy it down to rest.
+    unsigned char * first = &t->data[ ( ( size_t )( y ) * TEX.width + x ) * 4 ];
+    for ( int col = 0; col < w; ++col )
+    {
+        memcpy( &first[ col * 4 ], &tile, sizeof( NasrTile ) );
+    }
+    for ( int row = 1; row < h; ++row )
+    {
+        memcpy( &first[ ( size_t )( row ) * TEX.width * 4 ], first, w * sizeof( NasrTile ) );
+    }
+    MarkTilemapDirty( t, x, y, w, h );
 
-// TextGraphics Manipulation
-float NasrGraphicsTextGetXOffset( unsigned int id )
+    #undef TEX
+};
+
+NasrTile NasrGraphicsTilemapGetTile( unsigned int id, int x, int y )
 {
+    NasrTile tile = { 0, 0, 0, 255 };
+
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextGetXOffset Error: invalid id %u", id );
-            return NAN;
+            NasrLog( "NasrGraphicsTilemapGetTile Error: invalid id %u", id );
+            return tile;
         }
     #endif
-    return GetGraphic( id )->data.text.xoffset;
+
+    #define TEX textures[ t->tilemap ]
+    const NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
+
+    // Tiles outside map count as empty.
+    if ( x < 0 || y < 0 || x >= ( int )( TEX.width ) || y >= ( int )( TEX.height ) )
+    {
+        return tile;
+    }
+    memcpy( &tile, &t->data[ ( ( size_t )( y ) * TEX.width + x ) * 4 ], sizeof( NasrTile ) );
+    return tile;
+
+    #undef TEX
 };
 
-void NasrGraphicsTextSetXOffset( unsigned int id, float v )
+int NasrGraphicsTilemapRaycast( unsigned int id, float x, float y, float dx, float dy, float maxdist, NasrTileHit * hit )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextSetXOffset Error: invalid id %u", id );
-            return;
+            NasrLog( "NasrGraphicsTilemapRaycast Error: invalid id %u", id );
+            return 0;
         }
     #endif
-    GetGraphic( id )->data.text.xoffset = v;
+
+    #define TEX textures[ t->tilemap ]
+    const NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
+
+    const float len = sqrtf( dx * dx + dy * dy );
+    if ( len == 0.0f )
+    {
+        return 0;
+    }
+    const float ux = dx / len;
+    const float uy = dy / len;
+    const float tilew = ( float )( t->tilew );
+    const float tileh = ( float )( t->tileh );
+    const int mapw = ( int )( TEX.width );
+    const int maph = ( int )( TEX.height );
+
+    // Walk tiles ray crosses in order ( DDA ), so cost is only # o’ tiles touched.
+    const float px = x - t->dest.x;
+    const float py = y - t->dest.y;
+    int cx = ( int )( floorf( px / tilew ) );
+    int cy = ( int )( floorf( py / tileh ) );
+    const int stepx = ux > 0.0f ? 1 : -1;
+    const int stepy = uy > 0.0f ? 1 : -1;
+    float nextx = ux != 0.0f ? ( ( ( float )( ux > 0.0f ? cx + 1 : cx ) * tilew ) - px ) / ux : FLT_MAX;
+    float nexty = uy != 0.0f ? ( ( ( float )( uy > 0.0f ? cy + 1 : cy ) * tileh ) - py ) / uy : FLT_MAX;
+    const float deltax = ux != 0.0f ? tilew / fabsf( ux ) : FLT_MAX;
+    const float deltay = uy != 0.0f ? tileh / fabsf( uy ) : FLT_MAX;
+    float distance = 0.0f;
+    int normalx = 0;
+    int normaly = 0;
+
+    while ( distance <= maxdist )
+    {
+        if ( cx >= 0 && cy >= 0 && cx < mapw && cy < maph )
+        {
+            if ( TilemapSolidAt( t, cx, cy ) )
+            {
+                if ( hit )
+                {
+                    hit->x = cx;
+                    hit->y = cy;
+                    hit->distance = distance;
+                    hit->normalx = normalx;
+                    hit->normaly = normaly;
+                }
+                return 1;
+            }
+        }
+        // Once outside map & heading further out, nothing left to hit.
+        else if
+        (
+            ( cx < 0 && stepx < 0 ) || ( cx >= mapw && stepx > 0 ) || ( cx < 0 && ux == 0.0f ) || ( cx >= mapw && ux == 0.0f ) ||
+            ( cy < 0 && stepy < 0 ) || ( cy >= maph && stepy > 0 ) || ( cy < 0 && uy == 0.0f ) || ( cy >= maph && uy == 0.0f )
+        )
+        {
+            break;
+        }
+
+        if ( nextx < nexty )
+        {
+            cx += stepx;
+            distance = nextx;
+            nextx += deltax;
+            normalx = -stepx;
+            normaly = 0;
+        }
+        else
+        {
+            cy += stepy;
+            distance = nexty;
+            nexty += deltay;
+            normalx = 0;
+            normaly = -stepy;
+        }
+    }
+    return 0;
+
+    #undef TEX
 };
 
-void NasrGraphicsTextAddToXOffset( unsigned int id, float v )
+unsigned int NasrGraphicsTilemapOverlapRect( unsigned int id, NasrRect rect )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextAddToXOffset Error: invalid id %u", id );
-            return;
+            NasrLog( "NasrGraphicsTilemapOverlapRect Error: invalid id %u", id );
+            return 0;
         }
     #endif
-    GetGraphic( id )->data.text.xoffset += v;
+
+    #define TEX textures[ t->tilemap ]
+    const NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
+
+    // Convert pixel rect into range o’ tiles it touches; edges that only touch tile boundary don’t count.
+    const float left = ( rect.x - t->dest.x ) / ( float )( t->tilew );
+    const float top = ( rect.y - t->dest.y ) / ( float )( t->tileh );
+    const float right = ( rect.x + rect.w - t->dest.x ) / ( float )( t->tilew );
+    const float bottom = ( rect.y + rect.h - t->dest.y ) / ( float )( t->tileh );
+    const int x = NASR_MATH_MAX( ( int )( floorf( left ) ), 0 );
+    const int y = NASR_MATH_MAX( ( int )( floorf( top ) ), 0 );
+    const int x2 = NASR_MATH_MIN( ( int )( ceilf( right ) ), ( int )( TEX.width ) );
+    const int y2 = NASR_MATH_MIN( ( int )( ceilf( bottom ) ), ( int )( TEX.height ) );
+    if ( x2 <= x || y2 <= y )
+    {
+        return 0;
+    }
+
+    unsigned int count = 0;
+    for ( int row = y; row < y2; ++row )
+    {
+        // Skip rows with no solid tiles without scanning them.
+        if ( t->solid_rows[ row ] > 0 )
+        {
+            count += CountTilemapSolidBits( &t->solid[ ( size_t )( row ) * t->solid_stride ], x, x2 - x );
+        }
+    }
+    return count;
+
+    #undef TEX
 };
 
-float NasrGraphicsTextGetYOffset( unsigned int id )
+float NasrGraphicsTilemapGetOpacity( unsigned int id )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextGetYOffset Error: invalid id %u", id );
-            return NAN;
+            NasrLog( "NasrGraphicsTilemapGetOpacity Error: invalid id %u", id );
+            return 0.0f;
         }
     #endif
-    return GetGraphic( id )->data.text.yoffset;
+
+    NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
+    return t->opacity;
 };
 
-void NasrGraphicsTextSetYOffset( unsigned int id, float v )
+void NasrGraphicsTilemapSetOpacity( unsigned int id, float opacity )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextSetYOffset Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsTilemapSetOpacity Error: invalid id %u", id );
             return;
         }
     #endif
-    GetGraphic( id )->data.text.yoffset = v;
+
+    NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
+    t->opacity = opacity;
 };
 
-void NasrGraphicsTextAddToYOffset( unsigned int id, float v )
+void NasrGraphicsTilemapSetBaked( unsigned int id, int_fast8_t baked )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextAddToYOffset Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsTilemapSetBaked Error: invalid id %u", id );
             return;
         }
     #endif
-    GetGraphic( id )->data.text.yoffset += v;
+
+    NasrGraphicTilemap * t = &GetGraphic( id )->data.tilemap;
+    ClearTilemapBake( t );
+    t->bake = baked ? 1 : 0;
+    t->bake_check = 1;
+    t->bake_chunksw = ( ( unsigned int )( t->dest.w ) + TILEMAP_BAKE_SIZE - 1 ) / TILEMAP_BAKE_SIZE;
+    t->bake_chunksh = ( ( unsigned int )( t->dest.h ) + TILEMAP_BAKE_SIZE - 1 ) / TILEMAP_BAKE_SIZE;
 };
 
-void NasrGraphicsTextSetCount( unsigned int id, int count )
+
+
+// ChunkedTilemapGraphics Manipulation
+void NasrGraphicsChunkedTilemapSetX( unsigned int id, float v )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextSetCount Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsChunkedTilemapSetX Error: invalid id %u", id );
             return;
         }
     #endif
-    NasrGraphicText * t = &GetGraphic( id )->data.text;
-    t->count = NASR_MATH_MIN( count, t->capacity );
+    GetGraphic( id )->data.chunked->x = v;
 };
 
-void NasrGraphicsTextIncrementCount( unsigned int id )
+void NasrGraphicsChunkedTilemapSetY( unsigned int id, float v )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsTextIncrementCount Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsChunkedTilemapSetY Error: invalid id %u", id );
             return;
         }
     #endif
-    NasrGraphicText * t = &GetGraphic( id )->data.text;
-    t->count = NASR_MATH_MIN( t->count + 1, t->capacity );
+    GetGraphic( id )->data.chunked->y = v;
 };
 
-void NasrSetTextOpacity( unsigned int id, float v )
+void NasrGraphicsChunkedTilemapSetTile( unsigned int id, unsigned int x, unsigned int y, NasrTile tile )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrSetTextOpacity Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsChunkedTilemapSetTile Error: invalid id %u", id );
             return;
         }
     #endif
-    GetGraphic( id )->data.text.opacity = v;
-};
 
+    NasrGraphicChunkedTilemap * t = GetGraphic( id )->data.chunked;
+    if ( x >= t->w || y >= t->h )
+    {
+        NasrLog( "NasrGraphicsChunkedTilemapSetTile Error: tile %u, %u outside map", x, y );
+        return;
+    }
+
+    const unsigned int c = ( y / TILEMAP_CHUNK_SIZE ) * t->chunksw + ( x / TILEMAP_CHUNK_SIZE );
+    unsigned char * chunk = GetTilemapChunk( t, c );
+    if ( !chunk )
+    {
+        NasrLog( "NasrGraphicsChunkedTilemapSetTile Error: ¡Not ’nough memory for tilemap chunk!" );
+        return;
+    }
+    const unsigned int i = ( ( y % TILEMAP_CHUNK_SIZE ) * TILEMAP_CHUNK_SIZE + ( x % TILEMAP_CHUNK_SIZE ) ) * 4;
+    chunk[ i ]     = tile.x;
+    chunk[ i + 1 ] = tile.y;
+    chunk[ i + 2 ] = tile.palette;
+    chunk[ i + 3 ] = tile.animation;
 
+    // Resident chunks get re-uploaded next time they’re drawn.
+    if ( t->chunk_slots[ c ] >= 0 )
+    {
+        t->slot_dirty[ t->chunk_slots[ c ] ] = 1;
+    }
+};
 
-// CounterGraphics Manipulation
-void NasrGraphicsCounterSetNumber( unsigned int id, float n )
+void NasrGraphicsChunkedTilemapSetChunk( unsigned int id, unsigned int cx, unsigned int cy, const NasrTile * tiles )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsCounterSetNumber Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsChunkedTilemapSetChunk Error: invalid id %u", id );
             return;
         }
     #endif
-    NasrGraphic * g = GetGraphic( id );
-    if ( !g )
+
+    NasrGraphicChunkedTilemap * t = GetGraphic( id )->data.chunked;
+    if ( cx >= t->chunksw || cy >= t->chunksh )
     {
+        NasrLog( "NasrGraphicsChunkedTilemapSetChunk Error: chunk %u, %u outside map", cx, cy );
         return;
     }
-    n = NASR_MATH_MIN( n, g->data.counter->maxnum );
-    int intnum = ( int )( floor( n ) );
-    int maxdigits = g->data.counter->maxdigits;
-    for ( int i = 0; i < g->data.counter->count; ++i )
-    {
-        float * vptr = &g->data.counter->vertices[ i * VERTEX_RECT_SIZE ];
-
-        const int c = i == maxdigits ? 10 : ( i > maxdigits ) ? NasrGetDigit( ( int )( floor( n * pow( 10, i - maxdigits ) ) ), 1 ) : NasrGetDigit( intnum, maxdigits - i );
-        CharNum * character = &charmaps.list[ g->data.counter->charset ].nums[ c ];
 
-        g->data.counter->chars[ i ].src = character->src;
-        g->data.counter->chars[ i ].dest.x = ( charmaps.list[ g->data.counter->charset ].numwidth * i ) + character->xoffset;
-        g->data.counter->chars[ i ].dest.y = character->yoffset;
-        g->data.counter->chars[ i ].dest.w = character->src.w;
-        g->data.counter->chars[ i ].dest.h = character->src.h;
+    const unsigned int c = cy * t->chunksw + cx;
 
-        glBindVertexArray( g->data.counter->vaos[ i ] );
-        glBindBuffer( GL_ARRAY_BUFFER, g->data.counter->vbos[ i ] );
-
-        ResetVertices( vptr );
-        const float texturew = ( float )( charmaps.list[ g->data.counter->charset ].texture.width );
-        const float textureh = ( float )( charmaps.list[ g->data.counter->charset ].texture.height );
-        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / texturew * character->src.x; // Left X
-        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / texturew * ( character->src.x + character->src.w );  // Right X
-        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / textureh * ( character->src.y + character->src.h ); // Top Y
-        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / textureh * character->src.y;  // Bottom Y
-
-        vptr[ 4 ] = g->data.counter->colors[ 3 ].r / 255.0f;
-        vptr[ 5 ] = g->data.counter->colors[ 3 ].g / 255.0f;
-        vptr[ 6 ] = g->data.counter->colors[ 3 ].b / 255.0f;
-        vptr[ 7 ] = g->data.counter->colors[ 3 ].a / 255.0f;
-
-        vptr[ 4 + VERTEX_SIZE ] = g->data.counter->colors[ 1 ].r / 255.0f;
-        vptr[ 5 + VERTEX_SIZE ] = g->data.counter->colors[ 1 ].g / 255.0f;
-        vptr[ 6 + VERTEX_SIZE ] = g->data.counter->colors[ 1 ].b / 255.0f;
-        vptr[ 7 + VERTEX_SIZE ] = g->data.counter->colors[ 1 ].a / 255.0f;
-
-        vptr[ 4 + VERTEX_SIZE * 2 ] = g->data.counter->colors[ 0 ].r / 255.0f;
-        vptr[ 5 + VERTEX_SIZE * 2 ] = g->data.counter->colors[ 0 ].g / 255.0f;
-        vptr[ 6 + VERTEX_SIZE * 2 ] = g->data.counter->colors[ 0 ].b / 255.0f;
-        vptr[ 7 + VERTEX_SIZE * 2 ] = g->data.counter->colors[ 0 ].a / 255.0f;
-
-        vptr[ 4 + VERTEX_SIZE * 3 ] = g->data.counter->colors[ 2 ].r / 255.0f;
-        vptr[ 5 + VERTEX_SIZE * 3 ] = g->data.counter->colors[ 2 ].g / 255.0f;
-        vptr[ 6 + VERTEX_SIZE * 3 ] = g->data.counter->colors[ 2 ].b / 255.0f;
-        vptr[ 7 + VERTEX_SIZE * 3 ] = g->data.counter->colors[ 2 ].a / 255.0f;
+    // Null tiles empties chunk, freeing its data & GPU slot.
+    if ( !tiles )
+    {
+        free( t->chunks[ c ] );
+        t->chunks[ c ] = 0;
+        if ( t->chunk_slots[ c ] >= 0 )
+        {
+            t->slot_chunks[ t->chunk_slots[ c ] ] = -1;
+            t->chunk_slots[ c ] = -1;
+        }
+        return;
+    }
 
-        BufferVertices( vptr );
-       
-        #undef CHARACTER
+    unsigned char * chunk = GetTilemapChunk( t, c );
+    if ( !chunk )
+    {
+        NasrLog( "NasrGraphicsChunkedTilemapSetChunk Error: ¡Not ’nough memory for tilemap chunk!" );
+        return;
+    }
+    memcpy( chunk, tiles, TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE * sizeof( NasrTile ) );
+    if ( t->chunk_slots[ c ] >= 0 )
+    {
+        t->slot_dirty[ t->chunk_slots[ c ] ] = 1;
     }
-    ClearBufferBindings(); 
 };
 
-void NasrGraphicsCounterSetOpacity( unsigned int id, float v )
+
+// LayeredTilemapGraphics Manipulation
+void NasrGraphicsLayeredTilemapSetX( unsigned int id, float v )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsCounterSetOpacity Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsLayeredTilemapSetX Error: invalid id %u", id );
             return;
         }
     #endif
-    GetGraphic( id )->data.counter->opacity = v;
+    GetGraphic( id )->data.layered->x = v;
 };
 
-void NasrGraphicsCounterSetXOffset( unsigned id, float v )
+void NasrGraphicsLayeredTilemapSetY( unsigned int id, float v )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsCounterSetXOffset Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsLayeredTilemapSetY Error: invalid id %u", id );
             return;
         }
     #endif
-    GetGraphic( id )->data.counter->xoffset = v;
+    GetGraphic( id )->data.layered->y = v;
 };
 
-void NasrGraphicsCounterSetYOffset( unsigned id, float v )
+void NasrGraphicsLayeredTilemapSetLayerScroll( unsigned int id, unsigned int layer, float scrollx, float scrolly )
 {
     #ifdef NASR_SAFE
         if ( id >= max_graphics )
         {
-            NasrLog( "NasrGraphicsCounterSetYOffset Error: invalid id %u", id );
+            NasrLog( "NasrGraphicsLayeredTilemapSetLayerScroll Error: invalid id %u", id );
             return;
         }
     #endif
-    GetGraphic( id )->data.counter->yoffset = v;
-};
-
 
-
-// Texture
-int NasrLoadFileAsTexture( const char * filename )
-{
-    return NasrLoadFileAsTextureEx( filename, NASR_SAMPLING_DEFAULT, NASR_INDEXED_DEFAULT );
+    NasrGraphicLayeredTilemap * t = GetGraphic( id )->data.layered;
+    if ( layer >= t->layer_count )
+    {
+        NasrLog( "NasrGraphicsLayeredTilemapSetLayerScroll Error: invalid layer %u", layer );
+        return;
+    }
+    t->scrollx[ layer ] = scrollx;
+    t->scrolly[ layer ] = scrolly;
 };
 
-int NasrLoadFileAsTextureEx( const char * filename, int sampling, int indexed )
+void NasrGraphicsLayeredTilemapSetLayerOpacity( unsigned int id, unsigned int layer, float opacity )
 {
-    const hash_t needle_hash = TextureMapHashString( filename );
-    TextureMapEntry * entry = &texture_map[ needle_hash ];
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsLayeredTilemapSetLayerOpacity Error: invalid id %u", id );
+            return;
+        }
+    #endif
 
-    // If root entry itself is empty, just fill it in.
-    if ( !entry->key.string )
+    NasrGraphicLayeredTilemap * t = GetGraphic( id )->data.layered;
+    if ( layer >= t->layer_count )
     {
-        entry->key.string = ( char * )( malloc( strlen( filename ) + 1 ) );
-        strcpy( entry->key.string, filename );
-        entry->key.hash = needle_hash;
-        entry->value = texture_count;
-        entry->next = 0;
+        NasrLog( "NasrGraphicsLayeredTilemapSetLayerOpacity Error: invalid layer %u", layer );
+        return;
     }
-    else
-    {
-        const int cmp = strcmp( entry->key.string, filename );
-        // If root entry has the same string, it's what we're looking for, so just return its value.
-        if ( cmp == 0 )
-        {
-            return entry->value;
-        }
-        // If root entry is alphabetically after what we're looking for, we already know it's not here.
-        // Add new entry & set as new root & move ol’ root to new root's next node.
-        else if ( cmp > 0 )
+    t->opacity[ layer ] = opacity;
+};
+
+void NasrGraphicsLayeredTilemapSetTile( unsigned int id, unsigned int layer, unsigned int x, unsigned int y, NasrTile tile )
+{
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            TextureMapEntry * new_entry = calloc( 1, sizeof( TextureMapEntry ) );
-            *new_entry = *entry;
-            entry->key.string = ( char * )( malloc( strlen( filename ) + 1 ) );
-            strcpy( entry->key.string, filename );
-            entry->key.hash = needle_hash;
-            entry->value = texture_count;
-            entry->next = new_entry;
+            NasrLog( "NasrGraphicsLayeredTilemapSetTile Error: invalid id %u", id );
+            return;
         }
-        else
-        {
-            int cmp = -1;
-            TextureMapEntry * preventry;
-
-            // Loop thru linked list till we reach entry whose string is alphabetically after what we’re looking for.
-            do
-            {
-                preventry = entry;
-                entry = entry->next;
-            }
-            while ( entry && ( ( cmp = strcmp( entry->key.string, filename ) ) > 0 ) );
-
-            // If the entry we stop on has the same string, we already have what we’re looking for, so just return its value.
-            if ( cmp == 0 )
-            {
-                return entry->value;
-            }
+    #endif
 
-            // Otherwise, this means we don’t have what we’re looking for, so add new entry & put it ’tween preventry & entry
-            // too keep linked list alphabetically ordered.
-            TextureMapEntry * new_entry = calloc( 1, sizeof( TextureMapEntry ) );
-            new_entry->key.string = ( char * )( malloc( strlen( filename ) + 1 ) );
-            strcpy( new_entry->key.string, filename );
-            new_entry->key.hash = needle_hash;
-            new_entry->value = texture_count;
-            new_entry->next = preventry->next;
-            preventry->next = new_entry;
-        }
+    NasrGraphicLayeredTilemap * t = GetGraphic( id )->data.layered;
+    if ( layer >= t->layer_count || x >= t->w || y >= t->h )
+    {
+        return;
     }
+    memcpy( &t->data[ ( ( ( size_t )( layer ) * t->h + y ) * t->w + x ) * 4 ], &tile, sizeof( NasrTile ) );
 
-    unsigned int width;
-    unsigned int height;
-    unsigned char * data = LoadTextureFileData( filename, &width, &height, sampling, indexed );
-    if ( !data )
+    // Grow layer’s dirty rect to cover this tile; it’s uploaded next time map is drawn.
+    NasrRectInt * r = &t->dirty[ layer ];
+    if ( !( t->dirty_layers & ( 1 << layer ) ) )
     {
-        NasrLog( "NasrLoadFileAsTextureEx Error: could not load data from “%s”.", filename );
-        return -1;
+        r->x = x;
+        r->y = y;
+        r->w = 1;
+        r->h = 1;
+        t->dirty_layers |= 1 << layer;
+    }
+    else
+    {
+        const int x2 = NASR_MATH_MAX( r->x + r->w, ( int )( x ) + 1 );
+        const int y2 = NASR_MATH_MAX( r->y + r->h, ( int )( y ) + 1 );
+        r->x = NASR_MATH_MIN( r->x, ( int )( x ) );
+        r->y = NASR_MATH_MIN( r->y, ( int )( y ) );
+        r->w = x2 - r->x;
+        r->h = y2 - r->y;
     }
-    const int id = NasrAddTextureEx( data, width, height, sampling, indexed );
-    free( data );
-    return id;
 };
 
-int NasrAddTexture( unsigned char * data, unsigned int width, unsigned int height )
+
+
+// TextGraphics Manipulation
+float NasrGraphicsTextGetXOffset( unsigned int id )
 {
-    return NasrAddTextureEx( data, width, height, NASR_SAMPLING_DEFAULT, NASR_INDEXED_DEFAULT );
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsTextGetXOffset Error: invalid id %u", id );
+            return NAN;
+        }
+    #endif
+    return GetGraphic( id )->data.text.xoffset;
 };
 
-int NasrAddTextureEx( unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed )
+void NasrGraphicsTextSetXOffset( unsigned int id, float v )
 {
-    if ( texture_count >= max_textures )
-    {
-        const unsigned int prev_max_textures = max_textures;
-        Texture * new_textures = calloc( max_textures * 2, sizeof( Texture ) );
-        unsigned int * new_texture_ids = calloc( max_textures * 2, sizeof( unsigned int ) );
-        if ( !new_textures || !new_texture_ids )
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            NasrLog( "NasrAddTextureEx Error: ¡Not enough memory for textures!" );
-            return -1;
+            NasrLog( "NasrGraphicsTextSetXOffset Error: invalid id %u", id );
+            return;
         }
-        max_textures *= 2;
-        memcpy( new_textures, textures, sizeof( Texture ) * prev_max_textures );
-        memcpy( new_texture_ids, texture_ids, sizeof( unsigned int ) * prev_max_textures );
-        free( textures );
-        free( texture_ids );
-        textures = new_textures;
-        texture_ids = new_texture_ids;
-        glGenTextures( max_textures - prev_max_textures, &new_texture_ids[ prev_max_textures ] );
-    }
-
-    AddTexture( &textures[ texture_count ], texture_ids[ texture_count ], data, width, height, sampling, indexed );
-    return texture_count++;
+    #endif
+    GetGraphic( id )->data.text.xoffset = v;
 };
 
-int NasrAddTextureBlank( unsigned int width, unsigned int height )
+void NasrGraphicsTextAddToXOffset( unsigned int id, float v )
 {
-    return NasrAddTexture( 0, width, height );
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsTextAddToXOffset Error: invalid id %u", id );
+            return;
+        }
+    #endif
+    GetGraphic( id )->data.text.xoffset += v;
 };
 
-int NasrAddTextureBlankEx( unsigned int width, unsigned int height, int sampling, int indexed )
+float NasrGraphicsTextGetYOffset( unsigned int id )
 {
-    return NasrAddTextureEx( 0, width, height, sampling, indexed );
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsTextGetYOffset Error: invalid id %u", id );
+            return NAN;
+        }
+    #endif
+    return GetGraphic( id )->data.text.yoffset;
 };
 
-void NasrSetTextureAsTarget( unsigned int texture )
+void NasrGraphicsTextSetYOffset( unsigned int id, float v )
 {
-    if ( texture >= texture_count )
-    {
-        NasrLog( "NasrSetTextureAsTarget Error: texture #%d is beyond texture limit.", texture );
-        return;
-    }
-    glBindFramebuffer( GL_FRAMEBUFFER, framebuffer );
-    glFramebufferTexture( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture_ids[ texture ], 0 );
-    glViewport( 0, 0, textures[ texture ].width, textures[ texture ].height );
-    selected_texture = texture;
-    BindBuffers( max_graphics );
-    UpdateShaderOrtho( 0.0f, 0.0f, textures[ selected_texture ].width, textures[ selected_texture ].height );
-};
-
-void NasrReleaseTextureTarget()
-{
-    ResetVertices( GetVertices( max_graphics ) );
-    glClearColor( 0.0f, 0.0f, 0.0f, 0.0f );
-    glBindFramebuffer( GL_FRAMEBUFFER, 0 );
-    glViewport( magnified_canvas_x, magnified_canvas_y, magnified_canvas_width, magnified_canvas_height );
-    selected_texture = -1;
-    ClearBufferBindings();
-    UpdateShaderOrthoToCamera();
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsTextSetYOffset Error: invalid id %u", id );
+            return;
+        }
+    #endif
+    GetGraphic( id )->data.text.yoffset = v;
 };
 
-void NasrGetTexturePixels( unsigned int texture, void * pixels )
+void NasrGraphicsTextAddToYOffset( unsigned int id, float v )
 {
     #ifdef NASR_SAFE
-        if ( texture >= texture_count )
+        if ( id >= max_graphics )
         {
-            NasrLog( "NasrGetTexturePixels Error: texture #%u is beyond texture limit.", texture );
+            NasrLog( "NasrGraphicsTextAddToYOffset Error: invalid id %u", id );
             return;
         }
     #endif
-    glGetTextureImage
-    (
-        texture_ids[ texture ],
-  	    0,
-  	    GL_RGBA,
-  	    GL_UNSIGNED_BYTE,
-        textures[ texture ].width * textures[ texture ].height * 4,
-        pixels
-  	);
+    GetGraphic( id )->data.text.yoffset += v;
 };
 
-void NasrCopyTextureToTexture( unsigned int src, unsigned int dest, NasrRectInt srccoords, NasrRectInt destcoords )
+void NasrGraphicsTextSetCount( unsigned int id, int count )
 {
     #ifdef NASR_SAFE
-        if ( dest >= texture_count )
+        if ( id >= max_graphics )
         {
-            NasrLog( "NasrCopyTextureToTexture Error: texture #%u is beyond texture limit.", dest );
+            NasrLog( "NasrGraphicsTextSetCount Error: invalid id %u", id );
             return;
         }
     #endif
-    unsigned char pixels[ textures[ dest ].width * textures[ dest ].height * 4 ];
-    NasrGetTexturePixels( dest, pixels );
-    NasrApplyTextureToPixelData( src, pixels, srccoords, destcoords );
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ dest ] );
-    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, textures[ dest ].width, textures[ dest ].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+    NasrGraphicText * t = &GetGraphic( id )->data.text;
+    t->count = NASR_MATH_MIN( count, t->capacity );
 };
 
-void NasrApplyTextureToPixelData( unsigned int texture, unsigned char * dest, NasrRectInt srccoords, NasrRectInt destcoords )
+void NasrGraphicsTextIncrementCount( unsigned int id )
 {
     #ifdef NASR_SAFE
-        if ( texture >= texture_count )
+        if ( id >= max_graphics )
         {
-            NasrLog( "NasrApplyTextureToPixelData Error: texture #%u is beyond texture limit.", texture );
+            NasrLog( "NasrGraphicsTextIncrementCount Error: invalid id %u", id );
             return;
         }
     #endif
-    unsigned char src[ textures[ texture ].width * textures[ texture ].height * 4 ];
-    NasrGetTexturePixels( texture, src );
-    int maxx = srccoords.w;
-    if ( maxx + srccoords.x > textures[ texture ].width )
-    {
-        maxx = textures[ texture ].width - srccoords.x;
-    }
-    if ( maxx + destcoords.x > destcoords.w )
-    {
-        maxx = destcoords.w - destcoords.x;
-    }
-    maxx *= 4;
-    int maxh = srccoords.h;
-    if ( maxh + srccoords.y > textures[ texture ].height )
-    {
-        maxh = textures[ texture ].height - srccoords.y;
-    }
-    if ( maxh + destcoords.y > destcoords.h )
-    {
-        maxh = destcoords.h - destcoords.y;
-    }
-    for ( int y = 0; y < maxh; ++y )
-    {
-        const int srci = ( ( ( srccoords.y + y ) * textures[ texture ].width ) + srccoords.x ) * 4;
-        const int desti = ( ( ( destcoords.y + y ) * destcoords.w ) + destcoords.x ) * 4;
-        memcpy( &dest[ desti ], &src[ srci ], maxx );
-    }
+    NasrGraphicText * t = &GetGraphic( id )->data.text;
+    t->count = NASR_MATH_MIN( t->count + 1, t->capacity );
 };
 
-void NasrCopyPixelData( unsigned char * src, unsigned char * dest, NasrRectInt srccoords, NasrRectInt destcoords, int maxsrcw, int maxsrch )
+float NasrGraphicsTextGetScale( unsigned int id )
 {
-    int maxx = srccoords.w;
-    if ( maxx + srccoords.x > maxsrcw )
-    {
-        maxx = maxsrcw - srccoords.x;
-    }
-    if ( maxx + destcoords.x > destcoords.w )
-    {
-        maxx = destcoords.w - destcoords.x;
-    }
-    maxx *= 4;
-    int maxh = srccoords.h;
-    if ( maxh + srccoords.y > maxsrch )
-    {
-        maxh = maxsrch - srccoords.y;
-    }
-    if ( maxh + destcoords.y > destcoords.h )
-    {
-        maxh = destcoords.h - destcoords.y;
-    }
-    for ( int y = 0; y < maxh; ++y )
-    {
-        const int srci = ( ( ( srccoords.y + y ) * maxsrcw ) + srccoords.x ) * 4;
-        const int desti = ( ( ( destcoords.y + y ) * destcoords.w ) + destcoords.x ) * 4;
-        memcpy( &dest[ desti ], &src[ srci ], maxx );
-    }
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsTextGetScale Error: invalid id %u", id );
+            return NAN;
+        }
+    #endif
+    return GetGraphic( id )->data.text.scale;
 };
 
-void NasrTileTexture( unsigned int texture, unsigned char * pixels, NasrRectInt srccoords, NasrRectInt destcoords )
+void NasrGraphicsTextSetScale( unsigned int id, float v )
 {
     #ifdef NASR_SAFE
-        if ( texture >= texture_count )
+        if ( id >= max_graphics )
         {
-            NasrLog( "NasrTileTexture Error: texture #%u is beyond texture limit.", texture );
+            NasrLog( "NasrGraphicsTextSetScale Error: invalid id %u", id );
             return;
         }
     #endif
-    NasrApplyTextureToPixelData( texture, pixels, srccoords, destcoords );
-    int w = srccoords.w;
-    int h = srccoords.h;
-    while ( w < destcoords.w && h < destcoords.h )
-    {
-        const NasrRectInt src4 = { 0, 0, w, h };
-        const NasrRectInt dest7 = { w, 0, destcoords.w, destcoords.h };
-        const NasrRectInt dest8 = { 0, h, destcoords.w, destcoords.h };
-        const NasrRectInt dest9 = { w, h, destcoords.w, destcoords.h };
-        NasrCopyPixelData( pixels, pixels, src4, dest7, destcoords.w, destcoords.h );
-        NasrCopyPixelData( pixels, pixels, src4, dest8, destcoords.w, destcoords.h );
-        NasrCopyPixelData( pixels, pixels, src4, dest9, destcoords.w, destcoords.h );
-        w *= 2;
-        h *= 2;
-    }
+    GetGraphic( id )->data.text.scale = v;
 };
 
-void NasrClearTextures( void )
+void NasrSetTextOpacity( unsigned int id, float v )
 {
-    for ( int i = 0; i < texture_map_size; ++i )
-    {
-        if
-        (
-            texture_map[ i ].key.string != NULL
-        )
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            free( texture_map[ i ].key.string );
-            texture_map[ i ].key.string = 0;
-            texture_map[ i ].key.hash = 0;
-            while ( texture_map[ i ].next )
-            {
-                TextureMapEntry * t = texture_map[ i ].next->next;
-                free( texture_map[ i ].next->key.string );
-                free( texture_map[ i ].next );
-                texture_map[ i ].next = t;
-            }
+            NasrLog( "NasrSetTextOpacity Error: invalid id %u", id );
+            return;
         }
-    }
-    texture_count = 0;
+    #endif
+    GetGraphic( id )->data.text.opacity = v;
 };
 
-unsigned int NasrTextureGetWidth( unsigned int texture )
+
+
+// TextStreamGraphics Manipulation
+void NasrGraphicsTextStreamSetCount( unsigned int id, int count )
 {
-    #if NASR_SAFE
-        if ( texture >= max_textures )
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            NasrLog( "NasrTextureGetWidth Error: texture #%u is beyond texture limit.", texture );
-            return 0;
+            NasrLog( "NasrGraphicsTextStreamSetCount Error: invalid id %u", id );
+            return;
         }
     #endif
-    return textures[ texture ].width;
+    NasrGraphicTextStream * t = GetGraphic( id )->data.stream;
+    t->count = NASR_MATH_MIN( ( unsigned int )( NASR_MATH_MAX( count, 0 ) ), t->glyph_count );
 };
 
-unsigned int NasrTextureGetHeight( unsigned int texture )
+void NasrGraphicsTextStreamIncrementCount( unsigned int id )
 {
-    #if NASR_SAFE
-        if ( texture >= max_textures )
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            NasrLog( "NasrTextureGetHeight Error: texture #%u is beyond texture limit.", texture );
-            return 0;
+            NasrLog( "NasrGraphicsTextStreamIncrementCount Error: invalid id %u", id );
+            return;
         }
     #endif
-    return textures[ texture ].height;
+    NasrGraphicTextStream * t = GetGraphic( id )->data.stream;
+    t->count = NASR_MATH_MIN( t->count + 1, t->glyph_count );
 };
 
-
-
-// Draw to Texture
-void NasrDrawRectToTexture( NasrRect rect, NasrColor color )
+float NasrGraphicsTextStreamGetScroll( unsigned int id )
 {
-    ResetVertices( GetVertices( max_graphics ) );
-    SetVerticesColorValues( GetVertices( max_graphics ), &color, &color, &color, &color );
-    rect.x *= canvas.w / textures[ selected_texture ].width;
-    rect.y = ( textures[ selected_texture ].height - ( rect.y + rect.h ) ) * ( canvas.h / textures[ selected_texture ].height );
-    rect.w *= canvas.w / textures[ selected_texture ].width;
-    rect.h *= canvas.h / textures[ selected_texture ].height;
-    DrawBox
-    (
-        vaos[ max_graphics ],
-        &rect,
-        0.0f,
-        0.0f
-    );
-    SetupVertices( vaos[ max_graphics ] );
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsTextStreamGetScroll Error: invalid id %u", id );
+            return NAN;
+        }
+    #endif
+    return GetGraphic( id )->data.stream->scroll;
 };
 
-void NasrDrawGradientRectToTexture( NasrRect rect, int dir, NasrColor color1, NasrColor color2 )
+void NasrGraphicsTextStreamSetScroll( unsigned int id, float v )
 {
-    NasrColor cul = color2;
-    NasrColor cur = color2;
-    NasrColor cbr = color1;
-    NasrColor cbl = color1;
-    switch ( dir )
-    {
-        case ( NASR_DIR_UP ):
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
+            NasrLog( "NasrGraphicsTextStreamSetScroll Error: invalid id %u", id );
+            return;
         }
-        break;
-        case ( NASR_DIR_UPRIGHT ):
+    #endif
+    GetGraphic( id )->data.stream->scroll = v;
+};
+
+void NasrGraphicsTextStreamAddToScroll( unsigned int id, float v )
+{
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            cul = color2;
-            cur = color1;
-            cbr = color1;
-            cbl = color1;
+            NasrLog( "NasrGraphicsTextStreamAddToScroll Error: invalid id %u", id );
+            return;
         }
-        break;
-        case ( NASR_DIR_RIGHT ):
+    #endif
+    GetGraphic( id )->data.stream->scroll += v;
+};
+
+float NasrGraphicsTextStreamGetHeight( unsigned int id )
+{
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            cul = color2;
-            cur = color1;
-            cbr = color2;
-            cbl = color1;
+            NasrLog( "NasrGraphicsTextStreamGetHeight Error: invalid id %u", id );
+            return NAN;
         }
-        break;
-        case ( NASR_DIR_DOWNRIGHT ):
+    #endif
+    const NasrGraphicTextStream * t = GetGraphic( id )->data.stream;
+    if ( !t->line_count )
+    {
+        return 0.0f;
+    }
+    const TextStreamLine * last = &t->lines[ t->line_count - 1 ];
+    return last->y + last->height - t->lines[ 0 ].y;
+};
+
+void NasrGraphicsTextStreamSetBudget( unsigned int id, unsigned int glyphs )
+{
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            cul = color1;
-            cur = color1;
-            cbr = color2;
-            cbl = color1;
+            NasrLog( "NasrGraphicsTextStreamSetBudget Error: invalid id %u", id );
+            return;
         }
-        break;
-        case ( NASR_DIR_DOWN ):
+    #endif
+    if ( glyphs == 0 )
+    {
+        NasrLog( "NasrGraphicsTextStreamSetBudget Error: budget must be @ least 1 glyph." );
+        return;
+    }
+    GetGraphic( id )->data.stream->budget = glyphs;
+};
+
+
+
+// CounterGraphics Manipulation
+void NasrGraphicsCounterSetNumber( unsigned int id, float n )
+{
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            cul = color1;
-            cur = color1;
-            cbr = color2;
-            cbl = color2;
+            NasrLog( "NasrGraphicsCounterSetNumber Error: invalid id %u", id );
+            return;
         }
-        break;
-        case ( NASR_DIR_DOWNLEFT ):
-        {
-            cul = color1;
-            cur = color1;
-            cbr = color1;
-            cbl = color2;
-        }
-        break;
-        case ( NASR_DIR_LEFT ):
-        {
-            cul = color1;
-            cur = color2;
-            cbr = color1;
-            cbl = color2;
-        }
-        break;
-        case ( NASR_DIR_UPLEFT ):
+    #endif
+    NasrGraphic * g = GetGraphic( id );
+    if ( !g )
+    {
+        return;
+    }
+    SetCounterDigits( g->data.counter, n );
+};
+
+void NasrGraphicsCounterSetOpacity( unsigned int id, float v )
+{
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            cul = color1;
-            cur = color2;
-            cbr = color1;
-            cbl = color1;
+            NasrLog( "NasrGraphicsCounterSetOpacity Error: invalid id %u", id );
+            return;
         }
-        break;
-        default:
+    #endif
+    GetGraphic( id )->data.counter->opacity = v;
+};
+
+void NasrGraphicsCounterSetXOffset( unsigned id, float v )
+{
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
         {
-            NasrLog( "¡Invalid gradient direction for NasrDrawGradientRectToTexture! %d\n", dir );
+            NasrLog( "NasrGraphicsCounterSetXOffset Error: invalid id %u", id );
+            return;
         }
-        break;
-    }
-    ResetVertices( GetVertices( max_graphics ) );
-    SetVerticesColorValues( GetVertices( max_graphics ), &cbl, &cbr, &cur, &cul );
-    rect.y = ( textures[ selected_texture ].height - ( rect.y + rect.h ) );
-    DrawBox
-    (
-        vaos[ max_graphics ],
-        &rect,
-        0.0f,
-        0.0f
-    );
-    SetupVertices( vaos[ max_graphics ] );
+    #endif
+    GetGraphic( id )->data.counter->xoffset = v;
 };
 
-void NasrDrawSpriteToTexture
-(
-    unsigned int texture,
-    NasrRect src,
-    NasrRect dest,
-    uint_fast8_t flip_x,
-    uint_fast8_t flip_y,
-    float rotation_x,
-    float rotation_y,
-    float rotation_z,
-    float opacity,
-    uint_fast8_t palette,
-    int_fast8_t useglobalpal,
-    float tilingx,
-    float tilingy
-)
+void NasrGraphicsCounterSetYOffset( unsigned id, float v )
 {
-    NasrGraphicSprite sprite;
-    sprite.texture = texture;
-    sprite.src = src;
-    sprite.dest = dest;
-    sprite.flip_x = flip_x;
-    sprite.flip_y = !flip_y;
-    sprite.rotation_x = rotation_x;
-    sprite.rotation_y = rotation_y;
-    sprite.rotation_z = rotation_z;
-    sprite.opacity = opacity;
-    sprite.palette = palette;
-    sprite.useglobalpal = useglobalpal;
-    sprite.tilingx = tilingx;
-    sprite.tilingy = tilingy;
-
-    ResetVertices( GetVertices( max_graphics ) );
-    sprite.dest.y = ( textures[ selected_texture ].height - ( sprite.dest.y + sprite.dest.h ) );
-
-    SetShader( sprite_shader );
-
-    UpdateSpriteVerticesValues( GetVertices( max_graphics ), &sprite );
-
-    SetVerticesView( sprite.dest.x + ( sprite.dest.w / 2.0f ), sprite.dest.y + ( sprite.dest.h / 2.0f ), 0.0f, 0.0f );
-
-    mat4 model = BASE_MATRIX;
-    vec3 scale = { sprite.dest.w, sprite.dest.h, 0.0 };
-    glm_scale( model, scale );
-    vec3 xrot = { 0.0, 1.0, 0.0 };
-    glm_rotate( model, DEGREES_TO_RADIANS( sprite.rotation_x ), xrot );
-    vec3 yrot = { 0.0, 0.0, 1.0 };
-    glm_rotate( model, DEGREES_TO_RADIANS( sprite.rotation_y ), yrot );
-    vec3 zrot = { 1.0, 0.0, 0.0 };
-    glm_rotate( model, DEGREES_TO_RADIANS( sprite.rotation_z ), zrot );
-    glUniformMatrix4fv( sprite_uniforms.model, 1, GL_FALSE, ( float * )( model ) );
-
-    glUniform1f( sprite_uniforms.opacity, ( float )( sprite.opacity ) );
-
-    glUniform2f( sprite_uniforms.tiling, sprite.tilingx, sprite.tilingy );
-
-    glActiveTexture( GL_TEXTURE0 );
-    glBindTexture( GL_TEXTURE_2D, texture_ids[ sprite.texture ] );
-    glUniform1i( sprite_uniforms.texture_data, 0 );
-    SetupVertices( vaos[ max_graphics ] );
+    #ifdef NASR_SAFE
+        if ( id >= max_graphics )
+        {
+            NasrLog( "NasrGraphicsCounterSetYOffset Error: invalid id %u", id );
+            return;
+        }
+    #endif
+    GetGraphic( id )->data.counter->yoffset = v;
 };
 
 
 
-// Debug Functions
-void NasrColorPrint( const NasrColor * c )
+// Texture
+int NasrLoadFileAsTexture( const char * filename )
 {
-    printf( "NasrColor: %f, %f, %f, %f\n", c->r, c->g, c->b, c->a );
+    return NasrLoadFileAsTextureEx( filename, NASR_SAMPLING_DEFAULT, NASR_INDEXED_DEFAULT );
 };
 
-void NasrDebugGraphics( void )
+int NasrLoadFileAsTextureEx( const char * filename, int sampling, int indexed )
 {
-    printf( "=================\n" );
-    for ( int i = 0; i < num_o_graphics; ++i )
+    // If file was already loaded, just return its texture.
+    const int existing = TextureMapLookup( filename, texture_count );
+    if ( existing > -1 )
     {
-        const int id = gfx_ptrs_pos_to_id[ i ];
-        const int pos = gfx_ptrs_id_to_pos[ id ];
-        const int state = state_for_gfx[ id ];
-        const int layer = layer_for_gfx[ id ];
-        printf( "%d : %d : %d : %d : %d\n", i, pos, id, state, layer );
+        return existing;
     }
-    printf( "=================\n" );
-    for ( int state = 0; state < max_states; ++state )
+
+    // Baked texture files go straight from disk to GL with no decoding.
+    if ( IsTextureFile( filename ) )
     {
-        printf( "%d: ", state );
-        for ( int layer = 0; layer < max_gfx_layers; ++layer )
+        size_t size;
+        void * file = NasrMapFile( filename, &size );
+        const TextureFileHeader * header = file ? GetTextureFileHeader( file, size ) : 0;
+        const int id = header ? AddTextureFromFile( header, sampling ) : -1;
+
+        // Remember the file’s own format, not the caller’s, so reloads match.
+        const int baked_indexed = header && header->format == TEXTURE_FILE_FORMAT_R8
+            ? NASR_INDEXED_YES
+            : NASR_INDEXED_NO;
+        if ( file )
         {
-            printf( "%d,", layer_pos[ GetStateLayerIndex( state, layer ) ] );
+            NasrUnmapFile( file, size );
         }
-        printf( "\n" );
+        if ( id < 0 )
+        {
+            NasrLog( "NasrLoadFileAsTextureEx Error: baked texture file “%s” is invalid.", filename );
+            return -1;
+        }
+        SetTextureSource( ( unsigned int )( id ), filename, sampling, baked_indexed );
+        return id;
     }
-    printf( "=================\n" );
-};
 
-void NasrRectPrint( const NasrRect * r )
-{
-    printf( "NasrRect: %f, %f, %f, %f\n", r->x, r->y, r->w, r->h );
+    unsigned int width;
+    unsigned int height;
+    unsigned char * data = LoadTextureFileData( filename, &width, &height, sampling, indexed, 0 );
+    if ( !data )
+    {
+        NasrLog( "NasrLoadFileAsTextureEx Error: could not load data from “%s”.", filename );
+        return -1;
+    }
+    const int id = AddTextureSlot( data, width, height, sampling, indexed, GetTextureChannels( indexed ) );
+    free( data );
+    if ( id > -1 )
+    {
+        SetTextureSource( ( unsigned int )( id ), filename, sampling, indexed );
+    }
+    return id;
 };
 
+int NasrBakeTextureFile( const char * src, const char * dest, int indexed )
+{
+    int w;
+    int h;
+    int channels;
+    unsigned char * data = stbi_load( src, &w, &h, &channels, STBI_rgb_alpha );
+    if ( data == NULL || w <= 0 || h <= 0 )
+    {
+        NasrLog( "NasrBakeTextureFile Error: couldn’t load texture file “%s”.", src );
+        return -1;
+    }
 
+    TextureFileHeader header;
+    memcpy( header.magic, TEXTURE_FILE_MAGIC, 4 );
+    header.version = TEXTURE_FILE_VERSION;
+    header.width = ( uint32_t )( w );
+    header.height = ( uint32_t )( h );
+    header.format = GetGLRGBA( indexed ) == GL_R8 ? TEXTURE_FILE_FORMAT_R8 : TEXTURE_FILE_FORMAT_RGBA8;
+    header.levels = 1;
 
-// Static functions
-static int AddGraphic
-(
-    unsigned int state,
-    unsigned int layer,
-    struct NasrGraphic graphic
-)
-{
-    if ( num_o_graphics >= max_graphics )
+    // Palette indices can’t be blended, so only full-color textures get mip chain.
+    if ( header.format == TEXTURE_FILE_FORMAT_RGBA8 )
     {
-        if ( !GrowGraphics() )
+        while ( ( w >> header.levels ) > 0 || ( h >> header.levels ) > 0 )
         {
-            return -1;
+            ++header.levels;
         }
     }
 
-    // Find last graphic of current layer.
-    unsigned int pp = state * max_gfx_layers + layer;
-    unsigned int p = layer_pos[ pp ];
-
-    // Push forward this & following positions.
-    for ( unsigned int i = pp; i < max_gfx_layers * max_states; ++i )
+    FILE * file = fopen( dest, "wb" );
+    if ( file == NULL )
     {
-        ++layer_pos[ i ];
+        NasrLog( "NasrBakeTextureFile Error: couldn’t open “%s” for writing.", dest );
+        free( data );
+        return -1;
     }
+    uint_fast8_t ok = fwrite( &header, sizeof( TextureFileHeader ), 1, file ) == 1;
 
-    // Push forward all following graphics.
-    for ( unsigned int i = num_o_graphics++; i > p; --i )
+    if ( header.format == TEXTURE_FILE_FORMAT_R8 )
     {
-        graphics[ i ] = graphics[ i - 1 ];
-
-        // Update pointers so they still point to correct graphics.
-        const unsigned int t = gfx_ptrs_pos_to_id[ i - 1 ];
-        ++gfx_ptrs_id_to_pos[ t ];
-        gfx_ptrs_pos_to_id[ gfx_ptrs_id_to_pos[ t ] ] = t;
+        // Indexed textures only need red channel, which holds palette index.
+        const size_t count = ( size_t )( w ) * h;
+        for ( size_t i = 0; i < count; ++i )
+        {
+            data[ i ] = data[ i * 4 ];
+        }
+        ok = ok && fwrite( data, 1, count, file ) == count;
     }
-
-    // Find 1st free graphic ID.
-    int current_graphic_id = -1;
-    for ( int i = 0; i < max_graphics; ++i )
+    else
     {
-        if ( gfx_ptrs_id_to_pos[ i ] == -1 )
+        // Each level is box-filtered from last 1 in place, since every pixel written is behind every pixel still to be read.
+        unsigned int lw = ( unsigned int )( w );
+        unsigned int lh = ( unsigned int )( h );
+        for ( unsigned int level = 0; level < header.levels; ++level )
         {
-            current_graphic_id = i;
-            break;
+            if ( level > 0 )
+            {
+                const unsigned int nw = NASR_MATH_MAX( lw / 2, 1 );
+                const unsigned int nh = NASR_MATH_MAX( lh / 2, 1 );
+                for ( unsigned int y = 0; y < nh; ++y )
+                {
+                    const unsigned int y0 = NASR_MATH_MIN( y * 2, lh - 1 );
+                    const unsigned int y1 = NASR_MATH_MIN( y * 2 + 1, lh - 1 );
+                    for ( unsigned int x = 0; x < nw; ++x )
+                    {
+                        const unsigned int x0 = NASR_MATH_MIN( x * 2, lw - 1 );
+                        const unsigned int x1 = NASR_MATH_MIN( x * 2 + 1, lw - 1 );
+                        for ( unsigned int c = 0; c < 4; ++c )
+                        {
+                            const unsigned int sum = data[ ( y0 * lw + x0 ) * 4 + c ]
+                                + data[ ( y0 * lw + x1 ) * 4 + c ]
+                                + data[ ( y1 * lw + x0 ) * 4 + c ]
+                                + data[ ( y1 * lw + x1 ) * 4 + c ];
+                            data[ ( y * nw + x ) * 4 + c ] = ( unsigned char )( ( sum + 2 ) / 4 );
+                        }
+                    }
+                }
+                lw = nw;
+                lh = nh;
+            }
+            const size_t bytes = ( size_t )( lw ) * lh * 4;
+            ok = ok && fwrite( data, 1, bytes, file ) == bytes;
         }
     }
 
-    if ( current_graphic_id == -1 )
+    free( data );
+    if ( fclose( file ) != 0 || !ok )
     {
-        NasrLog( "¡Strange error! ¡All graphics IDs filled e’en tho we’re apparently below max graphics!" );
+        NasrLog( "NasrBakeTextureFile Error: couldn’t write “%s”.", dest );
+        return -1;
     }
-
-    // Add current graphic & pointer.
-    graphics[ p ] = graphic;
-    gfx_ptrs_id_to_pos[ current_graphic_id ] = p;
-    gfx_ptrs_pos_to_id[ p ] = current_graphic_id;
-    state_for_gfx[ current_graphic_id ] = state;
-    layer_for_gfx[ current_graphic_id ] = layer;
-
-    return current_graphic_id;
+    return 0;
 };
 
-static void AddTexture( Texture * texture, unsigned int texture_id, const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed )
+int NasrLoadFileAsArrayTexture( const char * filename, int sampling, int indexed )
 {
-    const GLint sample_type = GetGLSamplingType( sampling );
-    const GLint index_type = GetGLRGBA( indexed );
+    // If file was already loaded, just return its texture.
+    const int existing = TextureMapLookup( filename, texture_count );
+    if ( existing > -1 )
+    {
+        return existing;
+    }
 
-    texture->width = width;
-    texture->height = height;
-    texture->indexed = index_type == GL_R8;
-    glBindTexture( GL_TEXTURE_2D, texture_id );
-    glTexImage2D( GL_TEXTURE_2D, 0, index_type, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sample_type );
-    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sample_type );
+    unsigned int width;
+    unsigned int height;
+    unsigned char * data = LoadTextureFileData( filename, &width, &height, sampling, indexed, IsTextureFile( filename ) );
+    if ( !data )
+    {
+        NasrLog( "NasrLoadFileAsArrayTexture Error: could not load data from “%s”.", filename );
+        return -1;
+    }
+    const int id = AddArrayTexture( data, width, height, sampling, indexed, GetTextureChannels( indexed ) );
+    free( data );
+    return id;
 };
 
-static void BindBuffers( unsigned int id )
+int NasrLoadFileAsAtlasTexture( const char * filename, int sampling, int indexed )
 {
-    glBindVertexArray( vaos[ id ] );
-    glBindBuffer( GL_ARRAY_BUFFER, vbos[ id ] );
-};
-
-static void BufferDefault( float * vptr )
-{
-    // EBO
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ebo );
+    // If file was already loaded, just return its texture.
+    const int existing = TextureMapLookup( filename, texture_count );
+    if ( existing > -1 )
+    {
+        return existing;
+    }
 
-    // VBO
-    glBufferData( GL_ARRAY_BUFFER, sizeof( vertices_base ), vptr, GL_STATIC_DRAW );
-    glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), 0 );
-    glEnableVertexAttribArray( 0 );
-    glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), ( void * )( 2 * sizeof( float ) ) );
-    glEnableVertexAttribArray( 1 );
-    glVertexAttribPointer( 2, 4, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), ( void * )( 4 * sizeof( float ) ) );
-    glEnableVertexAttribArray( 2 );
-    BufferVertices( vptr );
+    unsigned int width;
+    unsigned int height;
+    unsigned char * data = LoadTextureFileData( filename, &width, &height, sampling, indexed, IsTextureFile( filename ) );
+    if ( !data )
+    {
+        NasrLog( "NasrLoadFileAsAtlasTexture Error: could not load data from “%s”.", filename );
+        return -1;
+    }
+    const int id = AddAtlasTexture( data, width, height, sampling, indexed, GetTextureChannels( indexed ) );
+    free( data );
+    return id;
 };
 
-static void BufferVertices( float * vptr )
+int NasrLoadFileAsTextureAsync( const char * filename, int sampling, int indexed, NasrTextureLoadCallback callback )
 {
-    glBufferData( GL_ARRAY_BUFFER, sizeof( float ) * VERTEX_RECT_SIZE, vptr, GL_STATIC_DRAW );
-};
+    if ( !texture_loader.running && StartTextureLoader() != 0 )
+    {
+        return -1;
+    }
 
-static CharMapEntry * CharMapGenEntry( unsigned int id, const char * key )
-{
-    hash_t needle_hash = CharMapHashString( id, key );
-    CharMapEntry * entry = CharMapHashFindEntry( id, key, needle_hash );
-    if ( !entry->key.string )
+    TextureLoadJob * job = calloc( 1, sizeof( TextureLoadJob ) );
+    if ( !job )
     {
-        entry->key.string = ( char * )( malloc( strlen( key ) + 1 ) );
-        strcpy( entry->key.string, key );
-        entry->key.hash = needle_hash;
+        NasrLog( "NasrLoadFileAsTextureAsync Error: ¡Not ’nough memory to load “%s”!", filename );
+        return -1;
     }
-    return entry;
-};
+    job->callback = callback;
+    job->generation = texture_generation;
 
-static CharMapEntry * CharMapHashFindEntry( unsigned int id, const char * needle_string, hash_t needle_hash )
-{
-    while ( 1 )
+    // If file was already loaded or is loading, just wait for it to be ready.
+    const int existing = TextureMapLookup( filename, texture_count );
+    if ( existing > -1 )
     {
-        CharMapEntry * entry = &charmaps.list[ id ].list[ needle_hash ];
-        if ( entry->key.string == NULL || strcmp( entry->key.string, needle_string ) == 0 )
-        {
-            return entry;
-        }
-        needle_hash = ( needle_hash + 1 ) % charmaps.list[ id ].hashmax;
+        job->texture = ( unsigned int )( existing );
+        job->next = texture_loader.waiters;
+        texture_loader.waiters = job;
+        return existing;
+    }
+
+    // Hand out texture right away with blank placeholder that gets filled in once file is decoded.
+    const unsigned char placeholder[ 4 ] = { 0, 0, 0, 0 };
+    const int id = NasrAddTextureEx( ( unsigned char * )( placeholder ), 1, 1, sampling, indexed );
+    if ( id < 0 )
+    {
+        NasrLog( "NasrLoadFileAsTextureAsync Error: couldn’t start loading “%s”.", filename );
+        TextureMapRemove( filename );
+        free( job );
+        return -1;
+    }
+    job->texture = ( unsigned int )( id );
+    if ( QueueTextureLoad( job, filename, sampling, indexed ) != 0 )
+    {
+        // Forget placeholder so next request for file tries loading it ’gain.
+        NasrLog( "NasrLoadFileAsTextureAsync Error: couldn’t start loading “%s”.", filename );
+        TextureMapRemove( filename );
+        ReleaseTextureSlot( ( unsigned int )( id ) );
+        return -1;
     }
+    SetTextureSource( ( unsigned int )( id ), filename, sampling, indexed );
+    return id;
 };
 
-static uint32_t CharMapHashString( unsigned int id, const char * key )
+void NasrSetTextureUploadBudget( unsigned int bytes )
 {
-    return NasrHashString( key, charmaps.list[ id ].hashmax );
+    texture_loader.budget = bytes;
 };
 
-static void CharsetMalformedError( const char * msg, const char * file )
+void NasrSetTextureMemoryBudget( uint64_t bytes )
 {
-    NasrLog( "NasrAddCharset Error: Charset file “%s” malformed: “%s”.", file, msg );
+    texture_budget = bytes;
 };
 
-static void ClearBufferBindings( void )
+uint64_t NasrGetTextureMemoryUsage( void )
 {
-    glBindVertexArray( 0 );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    return texture_bytes;
 };
 
-static void DestroyGraphic( NasrGraphic * graphic )
+int NasrAddTexture( unsigned char * data, unsigned int width, unsigned int height )
 {
-    switch ( graphic->type )
-    {
-        case ( NASR_GRAPHIC_TEXT ):
-        {
-            if ( graphic->data.text.vaos )
-            {
-                glDeleteVertexArrays( graphic->data.text.capacity, graphic->data.text.vaos );
-                free( graphic->data.text.vaos );
-            }
-            if ( graphic->data.text.vbos )
-            {
-                glDeleteRenderbuffers( graphic->data.text.capacity, graphic->data.text.vbos );
-                free( graphic->data.text.vbos );
-            }
-            free( graphic->data.text.vertices );
-            free( graphic->data.text.chars );
-            graphic->type = NASR_GRAPHIC_NONE;
-        }
-        break;
-        case ( NASR_GRAPHIC_COUNTER ):
-        {
-            if ( graphic->data.counter )
-            {
-                if ( graphic->data.counter->vaos )
-                {
-                    glDeleteVertexArrays( graphic->data.counter->count, graphic->data.counter->vaos );
-                    free( graphic->data.counter->vaos );
-                }
-                if ( graphic->data.counter->vbos )
-                {
-                    glDeleteRenderbuffers( graphic->data.counter->count, graphic->data.counter->vbos );
-                    free( graphic->data.counter->vbos );
-                }
-                free( graphic->data.counter->vertices );
-                free( graphic->data.counter->chars );
-                free( graphic->data.counter );
-            }
-            graphic->type = NASR_GRAPHIC_NONE;
-        }
-        break;
-        case ( NASR_GRAPHIC_TILEMAP ):
-        {
-            if ( graphic->data.tilemap.data )
-            {
-                free( graphic->data.tilemap.data );
-            }
-            graphic->type = NASR_GRAPHIC_NONE;
-        }
-        break;
-    }
+    return NasrAddTextureEx( data, width, height, NASR_SAMPLING_DEFAULT, NASR_INDEXED_DEFAULT );
 };
 
-static void DrawBox( unsigned int vao, const NasrRect * rect, float scrollx, float scrolly )
+int NasrAddTextureEx( unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed )
 {
-    // Set shader.
-    SetShader( rect_shader );
-
-    // Set view.
-    SetVerticesView( rect->x + ( rect->w / 2.0f ), rect->y + ( rect->h / 2.0f ), scrollx, scrolly );
-
-    // Set scale.
-    mat4 model = BASE_MATRIX;
-    vec3 scale = { rect->w, rect->h, 0.0 };
-    glm_scale( model, scale );
-    glUniformMatrix4fv( rect_uniforms.model, 1, GL_FALSE, ( float * )( model ) );
+    return AddTextureSlot( data, width, height, sampling, indexed, 4 );
 };
 
-static void FramebufferSizeCallback( GLFWwindow * window, int screen_width, int screen_height )
+int NasrAddArrayTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed )
 {
-    double screen_aspect_ratio = ( double )( canvas.w / canvas.h );
-    double monitor_aspect_ratio = ( double )( screen_width ) / ( double )( screen_height );
+    return AddArrayTexture( data, width, height, sampling, indexed, 4 );
+};
 
-    // Base magnification on max that fits in window.
-    magnification = 
-        ( int )( floor(
-            ( monitor_aspect_ratio > screen_aspect_ratio )
-                ? ( double )( screen_height ) / ( double )( canvas.h )
-                : ( double )( screen_width ) / ( double )( canvas.w )
-        ));
-    if ( magnification < 1 )
-    {
-        magnification = 1;
-    }
+int NasrAddAtlasTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed )
+{
+    return AddAtlasTexture( data, width, height, sampling, indexed, 4 );
+};
 
-    magnified_canvas_width = canvas.w * magnification;
-    magnified_canvas_height = canvas.h * magnification;
-    magnified_canvas_x = ( int )( floor( ( double )( screen_width - magnified_canvas_width ) / 2.0 ) );
-    magnified_canvas_y = ( int )( floor( ( double )( screen_height - magnified_canvas_height ) / 2.0 ) );
-    glViewport( magnified_canvas_x, magnified_canvas_y, magnified_canvas_width, magnified_canvas_height );
+int NasrAddTextureBlank( unsigned int width, unsigned int height )
+{
+    return NasrAddTexture( 0, width, height );
 };
 
-static unsigned int GenerateShaderProgram( const NasrShader * shaders, int shadersnum )
+int NasrAddTextureBlankEx( unsigned int width, unsigned int height, int sampling, int indexed )
 {
-    unsigned int program = glCreateProgram();
-    unsigned int shader_ids[ shadersnum ];
+    return NasrAddTextureEx( 0, width, height, sampling, indexed );
+};
 
-    // Compile each shader and attach to program
-    for ( int i = 0; i < shadersnum; ++i )
+int NasrSetTilesetAnimations( unsigned int texture, const NasrTileAnimation * animations, unsigned int count )
+{
+    if ( texture >= texture_count )
     {
-        int success;
-        char infoLog[ 512 ];
-
-        GLenum type;
-        switch ( shaders[ i ].type )
-        {
-            case ( NASR_SHADER_VERTEX ):
-            {
-                type = GL_VERTEX_SHADER;
-            }
-            break;
-            case ( NASR_SHADER_FRAGMENT ):
-            {
-                type = GL_FRAGMENT_SHADER;
-            }
-            break;
-            default:
-            {
-                NasrLog( "Invalid shader type given to shader!" );
-            }
-            break;
-        }
-
-        shader_ids[ i ] = glCreateShader( type );
-        glShaderSource( shader_ids[ i ], 1, ( const GLchar * const * )( &shaders[ i ].code ), NULL );
-        glCompileShader( shader_ids[ i ] );
-        glGetShaderiv( shader_ids[ i ], GL_COMPILE_STATUS, &success );
-        if ( !success )
+        NasrLog( "NasrSetTilesetAnimations Error: texture #%u is beyond texture limit.", texture );
+        return -1;
+    }
+    if ( count > NASR_MAX_TILE_ANIMATIONS )
+    {
+        NasrLog( "NasrSetTilesetAnimations Error: %u animations given; max is %d.", count, NASR_MAX_TILE_ANIMATIONS );
+        return -1;
+    }
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        if ( animations[ i ].count > NASR_MAX_TILE_ANIMATION_FRAMES )
         {
-            glGetShaderInfoLog( shader_ids[ i ], 512, NULL, infoLog );
-            NasrLog( "ERROR::SHADER::VERTEX::COMPILATION_FAILED." );
-            NasrLog( infoLog );
+            NasrLog( "NasrSetTilesetAnimations Error: animation #%u has %u frames; max is %d.", i, animations[ i ].count, NASR_MAX_TILE_ANIMATION_FRAMES );
+            return -1;
         }
-        glAttachShader( program, shader_ids[ i ] );
     }
 
-    glLinkProgram( program );
-
-    // If there are any errors, log them
-    int  success;
-    char infoLog[ 512 ];
-    glGetProgramiv( program, GL_LINK_STATUS, &success );
-    if( !success )
+    // Passing no animations goes back to consecutive-frame animation.
+    ClearTileAnimations( &textures[ texture ] );
+    if ( count == 0 )
     {
-        glGetProgramInfoLog( program, 512, NULL, infoLog );
-        NasrLog( "ERROR: Failed to create shader program." );
-        NasrLog( infoLog );
+        return 0;
     }
 
-    // Delete shaders
-    for ( int i = 0; i < shadersnum; ++i )
+    TileAnimationTable * table = calloc( 1, sizeof( TileAnimationTable ) );
+    NasrTileAnimation * list = malloc( count * sizeof( NasrTileAnimation ) );
+    if ( !table || !list )
     {
-        glDeleteShader( shader_ids[ i ] );
+        NasrLog( "NasrSetTilesetAnimations Error: ¡Not ’nough memory for animation table!" );
+        free( table );
+        free( list );
+        return -1;
     }
+    memcpy( list, animations, count * sizeof( NasrTileAnimation ) );
+    table->count = count;
+    table->list = list;
 
-    return program;
-};
-
-static int GetCharacterSize( const char * s )
-{
-    const int code = ( int )( *s );
-    return ( code & ( 1 << 7 ) )
-        ? ( code & ( 1 << 5 ) )
-            ? ( code & ( 1 << 4 ) )
-                ? 4
-                : 3
-            : 2
-        : 1;
-};
-
-static GLint GetGLRGBA( int indexed )
-{
-    switch ( indexed )
+    // Current tile o’ each animation is kept in 256x1 integer texture, indexed by tile’s animation byte.
+    glGenTextures( 1, &table->texture );
+    SetTilemapTextureData( table->texture, 0, 256, 1 );
+    for ( unsigned int i = 0; i < count; ++i )
     {
-        case ( NASR_INDEXED_YES ): return GL_R8;
-        case ( NASR_INDEXED_NO ): return GL_RGBA;
-        default: return default_indexed_mode;
+        // Force 1st update to upload every entry.
+        table->frames[ ( i + 1 ) * 4 ] = ( unsigned char )( ~list[ i ].frames[ 0 ].x );
     }
+    UpdateTileAnimationTable( table );
+    textures[ texture ].animations = table;
+    ResetTextureBindings();
+    return 0;
 };
 
-static GLint GetGLSamplingType( int sampling )
+void NasrSetTextureAsTarget( unsigned int texture )
 {
-    switch ( sampling )
+    if ( texture >= texture_count )
     {
-        case ( NASR_SAMPLING_NEAREST ): return GL_NEAREST;
-        case ( NASR_SAMPLING_LINEAR ): return GL_LINEAR;
-        default: return default_sample_type;
+        NasrLog( "NasrSetTextureAsTarget Error: texture #%d is beyond texture limit.", texture );
+        return;
     }
-};
+    if ( textures[ texture ].atlas )
+    {
+        NasrLog( "NasrSetTextureAsTarget Error: texture #%u is packed into atlas & can’t be drawn onto.", texture );
+        return;
+    }
+    if ( ReloadEvictedTexture( texture ) != 0 )
+    {
+        return;
+    }
+    // Switching straight to ’nother target still finishes drawing on last 1.
+    if ( selected_texture >= 0 && ( unsigned int )( selected_texture ) != texture )
+    {
+        UpdateTextureMipmaps( selected_texture );
+    }
+    glBindFramebuffer( GL_FRAMEBUFFER, framebuffer );
+    AttachTextureToFramebuffer( GL_FRAMEBUFFER, texture );
+    glViewport( 0, 0, textures[ texture ].width, textures[ texture ].height );
+    selected_texture = texture;
+
+    // Drawn-on textures can’t be reloaded from file anymore.
+    textures[ texture ].evictable = 0;
+    ++textures[ texture ].version;
+    BindBuffers( max_graphics );
+    UpdateShaderOrtho( 0.0f, 0.0f, textures[ selected_texture ].width, textures[ selected_texture ].height );
+};
+
+void NasrReleaseTextureTarget()
+{
+    ResetVertices( GetVertices( max_graphics ) );
+    glClearColor( 0.0f, 0.0f, 0.0f, 0.0f );
+    glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+    glViewport( magnified_canvas_x, magnified_canvas_y, magnified_canvas_width, magnified_canvas_height );
+    if ( selected_texture >= 0 )
+    {
+        UpdateTextureMipmaps( selected_texture );
+        ++textures[ selected_texture ].version;
+    }
+    selected_texture = -1;
+    ClearBufferBindings();
+    UpdateShaderOrthoToCamera();
+};
+
+void NasrGetTexturePixels( unsigned int texture, void * pixels )
+{
+    #ifdef NASR_SAFE
+        if ( texture >= texture_count )
+        {
+            NasrLog( "NasrGetTexturePixels Error: texture #%u is beyond texture limit.", texture );
+            return;
+        }
+    #endif
+    if ( ReloadEvictedTexture( texture ) != 0 )
+    {
+        return;
+    }
+
+    // Standalone textures can be read whole; atlas & array textures only own their rect o’ page or layer.
+    if ( !textures[ texture ].atlas && !textures[ texture ].layered )
+    {
+        glBindTexture( GL_TEXTURE_2D, texture_ids[ texture ] );
+        glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels );
+        ResetTextureBindings();
+        return;
+    }
+
+    GLint prev_read_framebuffer;
+    glGetIntegerv( GL_READ_FRAMEBUFFER_BINDING, &prev_read_framebuffer );
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, copy_framebuffers[ 0 ] );
+    AttachTextureToFramebuffer( GL_READ_FRAMEBUFFER, texture );
+    glReadPixels
+    (
+        textures[ texture ].atlas ? textures[ texture ].atlas_x : 0,
+        textures[ texture ].atlas ? textures[ texture ].atlas_y : 0,
+        textures[ texture ].width,
+        textures[ texture ].height,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        pixels
+    );
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, prev_read_framebuffer );
+};
+
+void NasrCopyTextureToTexture( unsigned int src, unsigned int dest, NasrRectInt srccoords, NasrRectInt destcoords )
+{
+    #ifdef NASR_SAFE
+        if ( dest >= texture_count )
+        {
+            NasrLog( "NasrCopyTextureToTexture Error: texture #%u is beyond texture limit.", dest );
+            return;
+        }
+        if ( src >= texture_count )
+        {
+            NasrLog( "NasrCopyTextureToTexture Error: texture #%u is beyond texture limit.", src );
+            return;
+        }
+    #endif
+    if ( ReloadEvictedTexture( src ) != 0 || ReloadEvictedTexture( dest ) != 0 )
+    {
+        return;
+    }
+
+    // Clip copy to both src & dest, with destcoords’ w & h bounding dest like with pixel data.
+    int w = srccoords.w;
+    w = NASR_MATH_MIN( w, ( int )( textures[ src ].width ) - srccoords.x );
+    w = NASR_MATH_MIN( w, destcoords.w - destcoords.x );
+    w = NASR_MATH_MIN( w, ( int )( textures[ dest ].width ) - destcoords.x );
+    int h = srccoords.h;
+    h = NASR_MATH_MIN( h, ( int )( textures[ src ].height ) - srccoords.y );
+    h = NASR_MATH_MIN( h, destcoords.h - destcoords.y );
+    h = NASR_MATH_MIN( h, ( int )( textures[ dest ].height ) - destcoords.y );
+    if ( w <= 0 || h <= 0 || srccoords.x < 0 || srccoords.y < 0 || destcoords.x < 0 || destcoords.y < 0 )
+    {
+        return;
+    }
+
+    // Atlas textures are just rects in their page.
+    const int srcx = srccoords.x + ( textures[ src ].atlas ? ( int )( textures[ src ].atlas_x ) : 0 );
+    const int srcy = srccoords.y + ( textures[ src ].atlas ? ( int )( textures[ src ].atlas_y ) : 0 );
+    const int destx = destcoords.x + ( textures[ dest ].atlas ? ( int )( textures[ dest ].atlas_x ) : 0 );
+    const int desty = destcoords.y + ( textures[ dest ].atlas ? ( int )( textures[ dest ].atlas_y ) : 0 );
+
+    // Copied-onto textures can’t be reloaded from file anymore.
+    textures[ GetTextureStorage( dest ) ].evictable = 0;
+
+    // Blit straight ’tween textures on GPU so only requested rects get touched.
+    GLint prev_read_framebuffer;
+    GLint prev_draw_framebuffer;
+    glGetIntegerv( GL_READ_FRAMEBUFFER_BINDING, &prev_read_framebuffer );
+    glGetIntegerv( GL_DRAW_FRAMEBUFFER_BINDING, &prev_draw_framebuffer );
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, copy_framebuffers[ 0 ] );
+    AttachTextureToFramebuffer( GL_READ_FRAMEBUFFER, src );
+    glBindFramebuffer( GL_DRAW_FRAMEBUFFER, copy_framebuffers[ 1 ] );
+
+    // Blits within same image are undefined if rects o’erlap, so bounce those through temp texture.
+    if
+    (
+        GetTextureStorage( src ) == GetTextureStorage( dest )
+        && srcx < destx + w
+        && destx < srcx + w
+        && srcy < desty + h
+        && desty < srcy + h
+    )
+    {
+        GLuint temp;
+        glGenTextures( 1, &temp );
+        glBindTexture( GL_TEXTURE_2D, temp );
+        glTexImage2D( GL_TEXTURE_2D, 0, textures[ dest ].indexed ? GL_R8 : GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0 );
+        ResetTextureBindings();
+        glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, temp, 0 );
+        glBlitFramebuffer( srcx, srcy, srcx + w, srcy + h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST );
+        glFramebufferTexture( GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, temp, 0 );
+        AttachTextureToFramebuffer( GL_DRAW_FRAMEBUFFER, dest );
+        glBlitFramebuffer( 0, 0, w, h, destx, desty, destx + w, desty + h, GL_COLOR_BUFFER_BIT, GL_NEAREST );
+        glDeleteTextures( 1, &temp );
+    }
+    else
+    {
+        AttachTextureToFramebuffer( GL_DRAW_FRAMEBUFFER, dest );
+        glBlitFramebuffer( srcx, srcy, srcx + w, srcy + h, destx, desty, destx + w, desty + h, GL_COLOR_BUFFER_BIT, GL_NEAREST );
+    }
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, prev_read_framebuffer );
+    glBindFramebuffer( GL_DRAW_FRAMEBUFFER, prev_draw_framebuffer );
+    UpdateTextureMipmaps( GetTextureStorage( dest ) );
+    ++textures[ dest ].version;
+    ++textures[ GetTextureStorage( dest ) ].version;
+};
+
+void NasrApplyTextureToPixelData( unsigned int texture, unsigned char * dest, NasrRectInt srccoords, NasrRectInt destcoords )
+{
+    #ifdef NASR_SAFE
+        if ( texture >= texture_count )
+        {
+            NasrLog( "NasrApplyTextureToPixelData Error: texture #%u is beyond texture limit.", texture );
+            return;
+        }
+    #endif
+    if ( ReloadEvictedTexture( texture ) != 0 )
+    {
+        return;
+    }
+    unsigned char * src = malloc( ( size_t )( textures[ texture ].width ) * textures[ texture ].height * 4 );
+    if ( !src )
+    {
+        NasrLog( "NasrApplyTextureToPixelData Error: ¡Not ’nough memory to read texture #%u!", texture );
+        return;
+    }
+    NasrGetTexturePixels( texture, src );
+    int maxx = srccoords.w;
+    if ( maxx + srccoords.x > textures[ texture ].width )
+    {
+        maxx = textures[ texture ].width - srccoords.x;
+    }
+    if ( maxx + destcoords.x > destcoords.w )
+    {
+        maxx = destcoords.w - destcoords.x;
+    }
+    maxx *= 4;
+    int maxh = srccoords.h;
+    if ( maxh + srccoords.y > textures[ texture ].height )
+    {
+        maxh = textures[ texture ].height - srccoords.y;
+    }
+    if ( maxh + destcoords.y > destcoords.h )
+    {
+        maxh = destcoords.h - destcoords.y;
+    }
+    for ( int y = 0; y < maxh; ++y )
+    {
+        const int srci = ( ( ( srccoords.y + y ) * textures[ texture ].width ) + srccoords.x ) * 4;
+        const int desti = ( ( ( destcoords.y + y ) * destcoords.w ) + destcoords.x ) * 4;
+        memcpy( &dest[ desti ], &src[ srci ], maxx );
+    }
+    free( src );
+};
+
+void NasrCopyPixelData( unsigned char * src, unsigned char * dest, NasrRectInt srccoords, NasrRectInt destcoords, int maxsrcw, int maxsrch )
+{
+    int maxx = srccoords.w;
+    if ( maxx + srccoords.x > maxsrcw )
+    {
+        maxx = maxsrcw - srccoords.x;
+    }
+    if ( maxx + destcoords.x > destcoords.w )
+    {
+        maxx = destcoords.w - destcoords.x;
+    }
+    maxx *= 4;
+    int maxh = srccoords.h;
+    if ( maxh + srccoords.y > maxsrch )
+    {
+        maxh = maxsrch - srccoords.y;
+    }
+    if ( maxh + destcoords.y > destcoords.h )
+    {
+        maxh = destcoords.h - destcoords.y;
+    }
+    for ( int y = 0; y < maxh; ++y )
+    {
+        const int srci = ( ( ( srccoords.y + y ) * maxsrcw ) + srccoords.x ) * 4;
+        const int desti = ( ( ( destcoords.y + y ) * destcoords.w ) + destcoords.x ) * 4;
+        memcpy( &dest[ desti ], &src[ srci ], maxx );
+    }
+};
+
+void NasrTileTexture( unsigned int texture, unsigned char * pixels, NasrRectInt srccoords, NasrRectInt destcoords )
+{
+    #ifdef NASR_SAFE
+        if ( texture >= texture_count )
+        {
+            NasrLog( "NasrTileTexture Error: texture #%u is beyond texture limit.", texture );
+            return;
+        }
+    #endif
+    NasrApplyTextureToPixelData( texture, pixels, srccoords, destcoords );
+    const int w = NASR_MATH_MIN( srccoords.w, ( int )( textures[ texture ].width ) - srccoords.x );
+    const int h = NASR_MATH_MIN( srccoords.h, ( int )( textures[ texture ].height ) - srccoords.y );
+    if ( w <= 0 || h <= 0 || destcoords.x >= destcoords.w || destcoords.y >= destcoords.h )
+    {
+        return;
+    }
+
+    // Fill out 1st row o’ tiles by doubling what’s already copied, so each memcpy is as wide as possible.
+    const size_t stride = ( size_t )( destcoords.w ) * 4;
+    const size_t rowstart = ( size_t )( destcoords.x ) * 4;
+    const size_t rowsize = stride - rowstart;
+    const int tileh = NASR_MATH_MIN( h, destcoords.h - destcoords.y );
+    for ( int y = destcoords.y; y < destcoords.y + tileh; ++y )
+    {
+        unsigned char * row = &pixels[ y * stride + rowstart ];
+        size_t filled = NASR_MATH_MIN( ( size_t )( w ) * 4, rowsize );
+        while ( filled < rowsize )
+        {
+            const size_t n = NASR_MATH_MIN( filled, rowsize - filled );
+            memcpy( &row[ filled ], row, n );
+            filled += n;
+        }
+    }
+
+    // Rest o’ rows are just copies o’ rows 1 tile up.
+    for ( int y = destcoords.y + tileh; y < destcoords.h; ++y )
+    {
+        memcpy( &pixels[ y * stride + rowstart ], &pixels[ ( y - tileh ) * stride + rowstart ], rowsize );
+    }
+};
+
+void NasrTileTextureToTexture( unsigned int src, unsigned int dest, NasrRectInt srccoords, NasrRectInt destcoords )
+{
+    #ifdef NASR_SAFE
+        if ( src >= texture_count )
+        {
+            NasrLog( "NasrTileTextureToTexture Error: texture #%u is beyond texture limit.", src );
+            return;
+        }
+        if ( dest >= texture_count )
+        {
+            NasrLog( "NasrTileTextureToTexture Error: texture #%u is beyond texture limit.", dest );
+            return;
+        }
+    #endif
+    if ( ReloadEvictedTexture( src ) != 0 || ReloadEvictedTexture( dest ) != 0 )
+    {
+        return;
+    }
+    const int w = NASR_MATH_MIN( srccoords.w, ( int )( textures[ src ].width ) - srccoords.x );
+    const int h = NASR_MATH_MIN( srccoords.h, ( int )( textures[ src ].height ) - srccoords.y );
+    const int areaw = NASR_MATH_MIN( destcoords.w, ( int )( textures[ dest ].width ) ) - destcoords.x;
+    const int areah = NASR_MATH_MIN( destcoords.h, ( int )( textures[ dest ].height ) ) - destcoords.y;
+    if ( w <= 0 || h <= 0 || areaw <= 0 || areah <= 0 )
+    {
+        return;
+    }
+
+    // Whole standalone textures wrap with GL_REPEAT, so 1 tiled quad covers whole area.
+    if
+    (
+        !textures[ src ].atlas
+        && !textures[ dest ].atlas
+        && srccoords.x == 0
+        && srccoords.y == 0
+        && w == ( int )( textures[ src ].width )
+        && h == ( int )( textures[ src ].height )
+    )
+    {
+        const int prev_target = selected_texture;
+        NasrSetTextureAsTarget( dest );
+        glDisable( GL_BLEND );
+        const NasrRect srcrect = { 0.0f, 0.0f, ( float )( w ), ( float )( h ) };
+        const NasrRect destrect = { ( float )( destcoords.x ), ( float )( destcoords.y ), ( float )( areaw ), ( float )( areah ) };
+        NasrDrawSpriteToTexture( src, srcrect, destrect, 0, 0, 0.0f, 0.0f, 0.0f, 1.0f, 0, 0, ( float )( areaw ) / ( float )( w ), ( float )( areah ) / ( float )( h ) );
+        glEnable( GL_BLEND );
+        if ( prev_target > -1 )
+        {
+            NasrSetTextureAsTarget( ( unsigned int )( prev_target ) );
+        }
+        else
+        {
+            NasrReleaseTextureTarget();
+        }
+        return;
+    }
+
+    // Otherwise copy 1 tile in & keep doubling it with blits, which only takes log2 steps each way.
+    NasrCopyTextureToTexture( src, dest, srccoords, destcoords );
+    for ( int filled = w; filled < areaw; filled *= 2 )
+    {
+        const NasrRectInt from = { destcoords.x, destcoords.y, filled, h };
+        const NasrRectInt to = { destcoords.x + filled, destcoords.y, destcoords.w, destcoords.h };
+        NasrCopyTextureToTexture( dest, dest, from, to );
+    }
+    for ( int filled = h; filled < areah; filled *= 2 )
+    {
+        const NasrRectInt from = { destcoords.x, destcoords.y, areaw, filled };
+        const NasrRectInt to = { destcoords.x, destcoords.y + filled, destcoords.w, destcoords.h };
+        NasrCopyTextureToTexture( dest, dest, from, to );
+    }
+};
+
+void NasrClearTextures( void )
+{
+    // Names are all in 1 arena, so forgetting them is just emptying table & arena.
+    if ( texture_map )
+    {
+        memset( texture_map, 0, texture_map_size * sizeof( TextureMapEntry ) );
+    }
+    texture_map_count = 0;
+    texture_names_size = 0;
+
+    // Textures owned by live graphics stay, so slots can only be reused from after last o’ those.
+    unsigned int kept = 0;
+    for ( int i = 0; i < texture_count; ++i )
+    {
+        if ( textures[ i ].owned )
+        {
+            kept = i + 1;
+            continue;
+        }
+        ClearTileAnimations( &textures[ i ] );
+        free( textures[ i ].filename );
+        textures[ i ].filename = 0;
+        textures[ i ].evictable = textures[ i ].evicted = 0;
+        texture_bytes -= textures[ i ].bytes;
+        textures[ i ].bytes = 0;
+
+        // Give back storage now rather than waiting for slot to be reused.
+        glBindTexture( GL_TEXTURE_2D, texture_ids[ i ] );
+        glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0 );
+    }
+    ResetTextureBindings();
+    texture_count = kept;
+    for ( unsigned int i = 0; i < atlas_page_count; ++i )
+    {
+        free( atlas_pages[ i ].nodes );
+    }
+    atlas_page_count = 0;
+    for ( unsigned int i = 0; i < texture_array_count; ++i )
+    {
+        const TextureArray * a = &texture_arrays[ i ];
+        glDeleteTextures( 1, &a->id );
+        texture_bytes -= ( uint64_t )( a->width ) * a->height * a->capacity * ( a->indexed == GL_R8 ? 1 : 4 );
+    }
+    texture_array_count = 0;
+
+    // Loads still in flight are for textures that no longer exist.
+    ++texture_generation;
+    while ( texture_loader.waiters )
+    {
+        TextureLoadJob * next = texture_loader.waiters->next;
+        free( texture_loader.waiters );
+        texture_loader.waiters = next;
+    }
+};
+
+unsigned int NasrTextureGetWidth( unsigned int texture )
+{
+    #if NASR_SAFE
+        if ( texture >= max_textures )
+        {
+            NasrLog( "NasrTextureGetWidth Error: texture #%u is beyond texture limit.", texture );
+            return 0;
+        }
+    #endif
+    return textures[ texture ].width;
+};
+
+unsigned int NasrTextureGetHeight( unsigned int texture )
+{
+    #if NASR_SAFE
+        if ( texture >= max_textures )
+        {
+            NasrLog( "NasrTextureGetHeight Error: texture #%u is beyond texture limit.", texture );
+            return 0;
+        }
+    #endif
+    return textures[ texture ].height;
+};
+
+
+
+// Draw to Texture
+void NasrDrawRectToTexture( NasrRect rect, NasrColor color )
+{
+    ResetVertices( GetVertices( max_graphics ) );
+    SetVerticesColorValues( GetVertices( max_graphics ), &color, &color, &color, &color );
+    rect.x *= canvas.w / textures[ selected_texture ].width;
+    rect.y = ( textures[ selected_texture ].height - ( rect.y + rect.h ) ) * ( canvas.h / textures[ selected_texture ].height );
+    rect.w *= canvas.w / textures[ selected_texture ].width;
+    rect.h *= canvas.h / textures[ selected_texture ].height;
+    DrawBox
+    (
+        vaos[ max_graphics ],
+        &rect,
+        0.0f,
+        0.0f
+    );
+    SetupVertices( vaos[ max_graphics ] );
+};
+
+void NasrDrawGradientRectToTexture( NasrRect rect, int dir, NasrColor color1, NasrColor color2 )
+{
+    NasrColor cul = color2;
+    NasrColor cur = color2;
+    NasrColor cbr = color1;
+    NasrColor cbl = color1;
+    switch ( dir )
+    {
+        case ( NASR_DIR_UP ):
+        {
+        }
+        break;
+        case ( NASR_DIR_UPRIGHT ):
+        {
+            cul = color2;
+            cur = color1;
+            cbr = color1;
+            cbl = color1;
+        }
+        break;
+        case ( NASR_DIR_RIGHT ):
+        {
+            cul = color2;
+            cur = color1;
+            cbr = color2;
+            cbl = color1;
+        }
+        break;
+        case ( NASR_DIR_DOWNRIGHT ):
+        {
+            cul = color1;
+            cur = color1;
+            cbr = color2;
+            cbl = color1;
+        }
+        break;
+        case ( NASR_DIR_DOWN ):
+        {
+            cul = color1;
+            cur = color1;
+            cbr = color2;
+            cbl = color2;
+        }
+        break;
+        case ( NASR_DIR_DOWNLEFT ):
+        {
+            cul = color1;
+            cur = color1;
+            cbr = color1;
+            cbl = color2;
+        }
+        break;
+        case ( NASR_DIR_LEFT ):
+        {
+            cul = color1;
+            cur = color2;
+            cbr = color1;
+            cbl = color2;
+        }
+        break;
+        case ( NASR_DIR_UPLEFT ):
+        {
+            cul = color1;
+            cur = color2;
+            cbr = color1;
+            cbl = color1;
+        }
+        break;
+        default:
+        {
+            NasrLog( "¡Invalid gradient direction for NasrDrawGradientRectToTexture! %d\n", dir );
+        }
+        break;
+    }
+    ResetVertices( GetVertices( max_graphics ) );
+    SetVerticesColorValues( GetVertices( max_graphics ), &cbl, &cbr, &cur, &cul );
+    rect.y = ( textures[ selected_texture ].height - ( rect.y + rect.h ) );
+    DrawBox
+    (
+        vaos[ max_graphics ],
+        &rect,
+        0.0f,
+        0.0f
+    );
+    SetupVertices( vaos[ max_graphics ] );
+};
+
+void NasrDrawSpriteToTexture
+(
+    unsigned int texture,
+    NasrRect src,
+    NasrRect dest,
+    uint_fast8_t flip_x,
+    uint_fast8_t flip_y,
+    float rotation_x,
+    float rotation_y,
+    float rotation_z,
+    float opacity,
+    uint_fast8_t palette,
+    int_fast8_t useglobalpal,
+    float tilingx,
+    float tilingy
+)
+{
+    if ( ReloadEvictedTexture( texture ) != 0 )
+    {
+        return;
+    }
+
+    NasrGraphicSprite sprite;
+    sprite.texture = texture;
+    sprite.src = src;
+    sprite.dest = dest;
+    sprite.flip_x = flip_x;
+    sprite.flip_y = !flip_y;
+    sprite.rotation_x = rotation_x;
+    sprite.rotation_y = rotation_y;
+    sprite.rotation_z = rotation_z;
+    sprite.opacity = opacity;
+    sprite.palette = palette;
+    sprite.useglobalpal = useglobalpal;
+    sprite.tilingx = tilingx;
+    sprite.tilingy = tilingy;
+
+    ResetVertices( GetVertices( max_graphics ) );
+    sprite.dest.y = ( textures[ selected_texture ].height - ( sprite.dest.y + sprite.dest.h ) );
+
+    // Array textures need shader that picks their layer.
+    const SpriteUniforms * uniforms = textures[ texture ].layered ? &array_sprite_uniforms : &sprite_uniforms;
+    SetShader( textures[ texture ].layered ? array_sprite_shader : sprite_shader );
+
+    UpdateSpriteVerticesValues( GetVertices( max_graphics ), &sprite );
+
+    SetVerticesView( sprite.dest.x + ( sprite.dest.w / 2.0f ), sprite.dest.y + ( sprite.dest.h / 2.0f ), 0.0f, 0.0f );
+
+    mat4 model = BASE_MATRIX;
+    vec3 scale = { sprite.dest.w, sprite.dest.h, 0.0 };
+    glm_scale( model, scale );
+    vec3 xrot = { 0.0, 1.0, 0.0 };
+    glm_rotate( model, DEGREES_TO_RADIANS( sprite.rotation_x ), xrot );
+    vec3 yrot = { 0.0, 0.0, 1.0 };
+    glm_rotate( model, DEGREES_TO_RADIANS( sprite.rotation_y ), yrot );
+    vec3 zrot = { 1.0, 0.0, 0.0 };
+    glm_rotate( model, DEGREES_TO_RADIANS( sprite.rotation_z ), zrot );
+    glUniformMatrix4fv( uniforms->model, 1, GL_FALSE, ( float * )( model ) );
+
+    glUniform1f( uniforms->opacity, ( float )( sprite.opacity ) );
+
+    glUniform2f( uniforms->tiling, sprite.tilingx, sprite.tilingy );
+    SetSpriteAtlasRect( uniforms, texture );
+
+    glActiveTexture( GL_TEXTURE0 );
+    if ( textures[ texture ].layered )
+    {
+        glBindTexture( GL_TEXTURE_2D_ARRAY, texture_arrays[ textures[ texture ].array ].id );
+        glUniform1f( uniforms->layer, ( float )( textures[ texture ].layer ) );
+    }
+    else
+    {
+        glBindTexture( GL_TEXTURE_2D, texture_ids[ GetTextureStorage( sprite.texture ) ] );
+    }
+    glUniform1i( uniforms->texture_data, 0 );
+    SetupVertices( vaos[ max_graphics ] );
+    ResetTextureBindings();
+};
+
+
+
+// Debug Functions
+void NasrColorPrint( const NasrColor * c )
+{
+    printf( "NasrColor: %f, %f, %f, %f\n", c->r, c->g, c->b, c->a );
+};
+
+void NasrDebugGraphics( void )
+{
+    printf( "=================\n" );
+    for ( int i = 0; i < num_o_graphics; ++i )
+    {
+        const int id = gfx_ptrs_pos_to_id[ i ];
+        const int pos = gfx_ptrs_id_to_pos[ id ];
+        const int state = state_for_gfx[ id ];
+        const int layer = layer_for_gfx[ id ];
+        printf( "%d : %d : %d : %d : %d\n", i, pos, id, state, layer );
+    }
+    printf( "=================\n" );
+    for ( int state = 0; state < max_states; ++state )
+    {
+        printf( "%d: ", state );
+        for ( int layer = 0; layer < max_gfx_layers; ++layer )
+        {
+            printf( "%d,", layer_pos[ GetStateLayerIndex( state, layer ) ] );
+        }
+        printf( "\n" );
+    }
+    printf( "=================\n" );
+};
+
+void NasrRectPrint( const NasrRect * r )
+{
+    printf( "NasrRect: %f, %f, %f, %f\n", r->x, r->y, r->w, r->h );
+};
+
+
+
+// Static functions
+static int AddGraphic
+(
+    unsigned int state,
+    unsigned int layer,
+    struct NasrGraphic graphic
+)
+{
+    if ( num_o_graphics >= max_graphics )
+    {
+        if ( !GrowGraphics() )
+        {
+            return -1;
+        }
+    }
+
+    // Find last graphic of current layer.
+    unsigned int pp = state * max_gfx_layers + layer;
+    unsigned int p = layer_pos[ pp ];
+
+    // Push forward this & following positions.
+    for ( unsigned int i = pp; i < max_gfx_layers * max_states; ++i )
+    {
+        ++layer_pos[ i ];
+    }
+
+    // Push forward all following graphics.
+    for ( unsigned int i = num_o_graphics++; i > p; --i )
+    {
+        graphics[ i ] = graphics[ i - 1 ];
+
+        // Update pointers so they still point to correct graphics.
+        const unsigned int t = gfx_ptrs_pos_to_id[ i - 1 ];
+        ++gfx_ptrs_id_to_pos[ t ];
+        gfx_ptrs_pos_to_id[ gfx_ptrs_id_to_pos[ t ] ] = t;
+    }
+
+    // Find 1st free graphic ID.
+    int current_graphic_id = -1;
+    for ( int i = 0; i < max_graphics; ++i )
+    {
+        if ( gfx_ptrs_id_to_pos[ i ] == -1 )
+        {
+            current_graphic_id = i;
+            break;
+        }
+    }
+
+    if ( current_graphic_id == -1 )
+    {
+        NasrLog( "¡Strange error! ¡All graphics IDs filled e’en tho we’re apparently below max graphics!" );
+    }
+
+    // Add current graphic & pointer.
+    graphics[ p ] = graphic;
+    gfx_ptrs_id_to_pos[ current_graphic_id ] = p;
+    gfx_ptrs_pos_to_id[ p ] = current_graphic_id;
+    state_for_gfx[ current_graphic_id ] = state;
+    layer_for_gfx[ current_graphic_id ] = layer;
+
+    return current_graphic_id;
+};
+
+static int AddArrayTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels )
+{
+    // Take texture slot 1st so ID matches what file lookup already recorded.
+    const unsigned char placeholder[ 4 ] = { 0, 0, 0, 0 };
+    const int id = AddTextureSlot( placeholder, 1, 1, sampling, indexed, 4 );
+    if ( id < 0 )
+    {
+        return -1;
+    }
+
+    // Find array for textures this size & format with room left, growing it if need be.
+    const GLint sample_type = GetGLSamplingType( sampling );
+    const GLint index_type = GetGLRGBA( indexed );
+    TextureArray * array = 0;
+    for ( unsigned int i = 0; i < texture_array_count; ++i )
+    {
+        TextureArray * a = &texture_arrays[ i ];
+        if
+        (
+            a->width == width
+            && a->height == height
+            && a->sampling == sample_type
+            && a->indexed == index_type
+            && ( a->count < a->capacity || GrowTextureArray( a ) == 0 )
+        )
+        {
+            array = a;
+            break;
+        }
+    }
+
+    if ( !array && texture_array_count < MAX_TEXTURE_ARRAYS )
+    {
+        const GLuint array_id = CreateTextureArray( width, height, TEXTURE_ARRAY_START_LAYERS, sample_type, index_type );
+        if ( array_id )
+        {
+            array = &texture_arrays[ texture_array_count++ ];
+            array->id = array_id;
+            array->width = width;
+            array->height = height;
+            array->sampling = sample_type;
+            array->indexed = index_type;
+            array->capacity = TEXTURE_ARRAY_START_LAYERS;
+            array->count = 0;
+        }
+    }
+
+    // If no array can take it, just give it its own texture.
+    if ( !array )
+    {
+        AddTexture( &textures[ id ], texture_ids[ id ], data, width, height, sampling, indexed, channels );
+        return id;
+    }
+
+    const unsigned int layer = array->count++;
+    glBindTexture( GL_TEXTURE_2D_ARRAY, array->id );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, channels == 1 ? 1 : 4 );
+    glTexSubImage3D( GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, channels == 1 ? GL_RED : GL_RGBA, GL_UNSIGNED_BYTE, data );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    if ( TextureMipmapped( array->sampling, array->indexed ) )
+    {
+        glGenerateMipmap( GL_TEXTURE_2D_ARRAY );
+    }
+    ResetTextureBindings();
+
+    textures[ id ].width = width;
+    textures[ id ].height = height;
+    textures[ id ].indexed = index_type == GL_R8;
+    textures[ id ].layered = 1;
+    textures[ id ].array = ( unsigned int )( array - texture_arrays );
+    textures[ id ].layer = layer;
+    ++textures[ id ].version;
+    return id;
+};
+
+static int AddAtlasTexture( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels )
+{
+    // Take texture slot 1st so ID matches what file lookup already recorded, e’en if new page gets added after.
+    const unsigned char placeholder[ 4 ] = { 0, 0, 0, 0 };
+    const int id = NasrAddTextureEx( ( unsigned char * )( placeholder ), 1, 1, sampling, indexed );
+    if ( id < 0 )
+    {
+        return -1;
+    }
+
+    // Images too big for any page just get their own texture.
+    if ( PackAtlasTexture( ( unsigned int )( id ), data, width, height, sampling, indexed, channels ) != 0 )
+    {
+        AddTexture( &textures[ id ], texture_ids[ id ], data, width, height, sampling, indexed, channels );
+    }
+    return id;
+};
+
+static void AddTexture( Texture * texture, unsigned int texture_id, const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels )
+{
+    const GLint sample_type = GetGLSamplingType( sampling );
+    const GLint index_type = GetGLRGBA( indexed );
+
+    texture->width = width;
+    texture->height = height;
+    texture->indexed = index_type == GL_R8;
+    texture->loading = 0;
+    texture->failed = 0;
+    texture->atlas = 0;
+    texture->layered = 0;
+    texture->evicted = 0;
+    texture->last_used = texture_frame;
+    ++texture->version;
+    texture_bytes -= texture->bytes;
+    texture->mipmapped = TextureMipmapped( sample_type, index_type );
+    texture->bytes = ( uint64_t )( width ) * height * ( texture->indexed ? 1 : 4 );
+
+    // Full mip chain adds ’bout a 3rd on top o’ base level.
+    if ( texture->mipmapped )
+    {
+        texture->bytes += texture->bytes / 3;
+    }
+    texture_bytes += texture->bytes;
+    glBindTexture( GL_TEXTURE_2D, texture_id );
+
+    // Single-channel data is just palette indices, tightly packed.
+    glPixelStorei( GL_UNPACK_ALIGNMENT, channels == 1 ? 1 : 4 );
+    glTexImage2D( GL_TEXTURE_2D, 0, index_type, width, height, 0, channels == 1 ? GL_RED : GL_RGBA, GL_UNSIGNED_BYTE, data );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+    SetTextureFilters( GL_TEXTURE_2D, sample_type, texture->mipmapped );
+
+    // Texture object may have had different level range before, like when reloaded after eviction.
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture->mipmapped ? 1000 : 0 );
+    if ( texture->mipmapped )
+    {
+        glGenerateMipmap( GL_TEXTURE_2D );
+    }
+};
+
+static int AddTextureFromFile( const TextureFileHeader * header, int sampling )
+{
+    const int indexed = header->format == TEXTURE_FILE_FORMAT_R8 ? NASR_INDEXED_YES : NASR_INDEXED_NO;
+    const int id = NasrAddTextureEx( 0, header->width, header->height, sampling, indexed );
+    if ( id < 0 )
+    {
+        return -1;
+    }
+
+    // Data’s already in texture’s final format, so each level goes straight from mapped file to GL.
+    const GLenum format = header->format == TEXTURE_FILE_FORMAT_R8 ? GL_RED : GL_RGBA;
+    const unsigned char * level_data = ( const unsigned char * )( header + 1 );
+    uint64_t bytes = 0;
+    glBindTexture( GL_TEXTURE_2D, texture_ids[ id ] );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    for ( unsigned int level = 0; level < header->levels; ++level )
+    {
+        const unsigned int lw = NASR_MATH_MAX( header->width >> level, 1 );
+        const unsigned int lh = NASR_MATH_MAX( header->height >> level, 1 );
+        glTexImage2D( GL_TEXTURE_2D, level, GetGLRGBA( indexed ), lw, lh, 0, format, GL_UNSIGNED_BYTE, level_data );
+        const size_t level_size = GetTextureFileLevelSize( header, level );
+        level_data += level_size;
+        bytes += level_size;
+    }
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header->levels - 1 );
+
+    // Use baked mips if file has them; only generate them if it doesn’t.
+    if ( textures[ id ].mipmapped && header->levels == 1 )
+    {
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000 );
+        glGenerateMipmap( GL_TEXTURE_2D );
+        bytes += bytes / 3;
+    }
+    ResetTextureBindings();
+
+    texture_bytes += bytes - textures[ id ].bytes;
+    textures[ id ].bytes = bytes;
+    return id;
+};
+
+static int AddTextureSlot( const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels )
+{
+    if ( texture_count >= max_textures )
+    {
+        const unsigned int prev_max_textures = max_textures;
+        Texture * new_textures = calloc( max_textures * 2, sizeof( Texture ) );
+        unsigned int * new_texture_ids = calloc( max_textures * 2, sizeof( unsigned int ) );
+        if ( !new_textures || !new_texture_ids )
+        {
+            NasrLog( "NasrAddTextureEx Error: ¡Not enough memory for textures!" );
+            return -1;
+        }
+        max_textures *= 2;
+        memcpy( new_textures, textures, sizeof( Texture ) * prev_max_textures );
+        memcpy( new_texture_ids, texture_ids, sizeof( unsigned int ) * prev_max_textures );
+        free( textures );
+        free( texture_ids );
+        textures = new_textures;
+        texture_ids = new_texture_ids;
+        glGenTextures( max_textures - prev_max_textures, &new_texture_ids[ prev_max_textures ] );
+    }
+
+    Texture * texture = &textures[ texture_count ];
+    free( texture->filename );
+    texture->filename = 0;
+    texture->evictable = 0;
+    texture->owned = 0;
+    AddTexture( texture, texture_ids[ texture_count ], data, width, height, sampling, indexed, channels );
+    return texture_count++;
+};
+
+static int AtlasPageFit( const AtlasPage * page, unsigned int i, unsigned int w, unsigned int h, unsigned int * y )
+{
+    // Rect sits @ top o’ highest skyline segment it spans, starting from segment i.
+    if ( page->nodes[ i ].x + w > page->size )
+    {
+        return 0;
+    }
+    unsigned int top = page->nodes[ i ].y;
+    unsigned int width_left = w;
+    while ( width_left > 0 )
+    {
+        if ( i >= page->node_count )
+        {
+            return 0;
+        }
+        top = NASR_MATH_MAX( top, page->nodes[ i ].y );
+        if ( top + h > page->size )
+        {
+            return 0;
+        }
+        if ( page->nodes[ i ].w >= width_left )
+        {
+            break;
+        }
+        width_left -= page->nodes[ i ].w;
+        ++i;
+    }
+    *y = top;
+    return 1;
+};
+
+static int AtlasPageInsert( AtlasPage * page, unsigned int w, unsigned int h, unsigned int * x, unsigned int * y )
+{
+    // Bottom-left skyline: pick spot that keeps skyline lowest, breaking ties by narrowest segment.
+    int best = -1;
+    unsigned int best_bottom = UINT_MAX;
+    unsigned int best_w = UINT_MAX;
+    unsigned int best_y = 0;
+    for ( unsigned int i = 0; i < page->node_count; ++i )
+    {
+        unsigned int top;
+        if ( AtlasPageFit( page, i, w, h, &top ) && ( top + h < best_bottom || ( top + h == best_bottom && page->nodes[ i ].w < best_w ) ) )
+        {
+            best = ( int )( i );
+            best_bottom = top + h;
+            best_w = page->nodes[ i ].w;
+            best_y = top;
+        }
+    }
+    if ( best < 0 )
+    {
+        return -1;
+    }
+
+    *x = page->nodes[ best ].x;
+    *y = best_y;
+
+    // Add new segment o’er placed rect & cut away segments it covers.
+    memmove( &page->nodes[ best + 1 ], &page->nodes[ best ], ( page->node_count - best ) * sizeof( AtlasSkylineNode ) );
+    page->nodes[ best ].x = *x;
+    page->nodes[ best ].y = best_y + h;
+    page->nodes[ best ].w = w;
+    ++page->node_count;
+    for ( unsigned int i = best + 1; i < page->node_count; )
+    {
+        const AtlasSkylineNode * prev = &page->nodes[ i - 1 ];
+        if ( page->nodes[ i ].x >= prev->x + prev->w )
+        {
+            break;
+        }
+        const unsigned int shrink = prev->x + prev->w - page->nodes[ i ].x;
+        if ( page->nodes[ i ].w > shrink )
+        {
+            page->nodes[ i ].x += shrink;
+            page->nodes[ i ].w -= shrink;
+            break;
+        }
+        memmove( &page->nodes[ i ], &page->nodes[ i + 1 ], ( page->node_count - i - 1 ) * sizeof( AtlasSkylineNode ) );
+        --page->node_count;
+    }
+
+    // Merge neighbors @ same height so skyline stays short.
+    for ( unsigned int i = 0; i + 1 < page->node_count; )
+    {
+        if ( page->nodes[ i ].y == page->nodes[ i + 1 ].y )
+        {
+            page->nodes[ i ].w += page->nodes[ i + 1 ].w;
+            memmove( &page->nodes[ i + 1 ], &page->nodes[ i + 2 ], ( page->node_count - i - 2 ) * sizeof( AtlasSkylineNode ) );
+            --page->node_count;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    return 0;
+};
+
+static void AttachTextureToFramebuffer( GLenum target, unsigned int texture )
+{
+    if ( textures[ texture ].layered )
+    {
+        glFramebufferTextureLayer( target, GL_COLOR_ATTACHMENT0, texture_arrays[ textures[ texture ].array ].id, 0, textures[ texture ].layer );
+        return;
+    }
+    glFramebufferTexture( target, GL_COLOR_ATTACHMENT0, texture_ids[ GetTextureStorage( texture ) ], 0 );
+};
+
+static void BakeTilemapChunk( NasrGraphicTilemap * tilemap, unsigned int vao, unsigned int chunk )
+{
+    const float cx = ( float )( chunk % tilemap->bake_chunksw ) * TILEMAP_BAKE_SIZE;
+    const float cy = ( float )( chunk / tilemap->bake_chunksw ) * TILEMAP_BAKE_SIZE;
+
+    if ( !tilemap->bake_textures[ chunk ] )
+    {
+        glGenTextures( 1, &tilemap->bake_textures[ chunk ] );
+        glBindTexture( GL_TEXTURE_2D, tilemap->bake_textures[ chunk ] );
+        glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, TILEMAP_BAKE_SIZE, TILEMAP_BAKE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0 );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+        ResetTextureBindings();
+    }
+
+    // Render chunk’s part o’ map straight into its texture, without blending so texels come out exactly as shader gives them.
+    GLfloat clear_color[ 4 ];
+    glGetFloatv( GL_COLOR_CLEAR_VALUE, clear_color );
+    glBindFramebuffer( GL_FRAMEBUFFER, bake_framebuffer );
+    glFramebufferTexture( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, tilemap->bake_textures[ chunk ], 0 );
+    glViewport( 0, 0, TILEMAP_BAKE_SIZE, TILEMAP_BAKE_SIZE );
+    glDisable( GL_BLEND );
+    glClearColor( 0.0f, 0.0f, 0.0f, 0.0f );
+    glClear( GL_COLOR_BUFFER_BIT );
+
+    const TilemapProgram * program = &tilemap_programs[ tilemap->program ];
+    const TilemapUniforms * uniforms = &program->uniforms;
+    SetShader( program->shader );
+
+    // Flip ortho so chunk’s top row lands in texture’s 1st row, matching how sprites sample textures.
+    mat4 ortho =
+    {
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f }
+    };
+    glm_ortho_rh_no( 0.0f, TILEMAP_BAKE_SIZE, 0.0f, TILEMAP_BAKE_SIZE, -1.0f, 1.0f, ortho );
+    const GLint ortho_location = glGetUniformLocation( program->shader, "ortho" );
+    glUniformMatrix4fv( ortho_location, 1, GL_FALSE, ( float * )( ortho ) );
+    SetVerticesView( ( tilemap->dest.w / 2.0f ) - cx, ( tilemap->dest.h / 2.0f ) - cy, 0.0f, 0.0f );
+
+    mat4 model = BASE_MATRIX;
+    vec3 scale = { tilemap->dest.w, tilemap->dest.h, 0.0 };
+    glm_scale( model, scale );
+    glUniformMatrix4fv( uniforms->model, 1, GL_FALSE, ( float * )( model ) );
+    glUniform2f( uniforms->tiling, 1.0f, 1.0f );
+    glUniform2f( uniforms->map_size, ( float )( textures[ tilemap->tilemap ].width ), ( float )( textures[ tilemap->tilemap ].height ) );
+    glUniform1f( uniforms->opacity, 1.0f );
+    BindTileAnimations( tilemap->texture, uniforms->frames, uniforms->animtable );
+    BindTexture( 0, texture_ids[ tilemap->texture ] );
+    glUniform1i( uniforms->texture, 0 );
+    BindTexture( 1, palette_texture_id );
+    glUniform1i( uniforms->palette, 1 );
+    FlushTilemap( tilemap );
+    BindTexture( 2, texture_ids[ tilemap->tilemap ] );
+    glUniform1i( uniforms->mapdata, 2 );
+    SetupVertices( vao );
+
+    // Put back whatever target, view & ortho were there before.
+    glm_ortho_rh_no( ortho_view.x, ortho_view.w, ortho_view.h, ortho_view.y, -1.0f, 1.0f, ortho );
+    glUniformMatrix4fv( ortho_location, 1, GL_FALSE, ( float * )( ortho ) );
+    glEnable( GL_BLEND );
+    glClearColor( clear_color[ 0 ], clear_color[ 1 ], clear_color[ 2 ], clear_color[ 3 ] );
+    if ( selected_texture >= 0 )
+    {
+        glBindFramebuffer( GL_FRAMEBUFFER, framebuffer );
+        glViewport( 0, 0, textures[ selected_texture ].width, textures[ selected_texture ].height );
+    }
+    else
+    {
+        glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+        glViewport( magnified_canvas_x, magnified_canvas_y, magnified_canvas_width, magnified_canvas_height );
+    }
+    tilemap->bake_stale[ chunk ] = 0;
+};
+
+static void BindBuffers( unsigned int id )
+{
+    glBindVertexArray( vaos[ id ] );
+    glBindBuffer( GL_ARRAY_BUFFER, vbos[ id ] );
+};
+
+static void BindTexture( unsigned int unit, GLuint texture )
+{
+    // Skip rebinding if unit already has this texture from an earlier draw this frame.
+    if ( bound_textures[ unit ] != texture )
+    {
+        glActiveTexture( GL_TEXTURE0 + unit );
+        glBindTexture( GL_TEXTURE_2D, texture );
+        bound_textures[ unit ] = texture;
+    }
+};
+
+static void BindTextureArray( unsigned int unit, GLuint texture )
+{
+    // Texture names are unique across targets, so arrays can share same cache.
+    if ( bound_textures[ unit ] != texture )
+    {
+        glActiveTexture( GL_TEXTURE0 + unit );
+        glBindTexture( GL_TEXTURE_2D_ARRAY, texture );
+        bound_textures[ unit ] = texture;
+    }
+};
+
+static void BindTileAnimations( unsigned int texture, GLint frames, GLint animtable )
+{
+    // Tilesets with animation table use it in place o’ shared frame table.
+    const TileAnimationTable * table = textures[ texture ].animations;
+    BindTexture( 3, table ? table->texture : animation_frames_texture_id );
+    glUniform1i( frames, 3 );
+    glUniform1i( animtable, table ? 1 : 0 );
+};
+
+static void BufferDefault( float * vptr )
+{
+    // EBO
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ebo );
+
+    // VBO
+    glBufferData( GL_ARRAY_BUFFER, sizeof( vertices_base ), vptr, GL_STATIC_DRAW );
+    glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), 0 );
+    glEnableVertexAttribArray( 0 );
+    glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), ( void * )( 2 * sizeof( float ) ) );
+    glEnableVertexAttribArray( 1 );
+    glVertexAttribPointer( 2, 4, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), ( void * )( 4 * sizeof( float ) ) );
+    glEnableVertexAttribArray( 2 );
+    BufferVertices( vptr );
+};
+
+static void BufferVertices( float * vptr )
+{
+    glBufferData( GL_ARRAY_BUFFER, sizeof( float ) * VERTEX_RECT_SIZE, vptr, GL_STATIC_DRAW );
+};
+
+static CharMapEntry * CharMapGenEntry( unsigned int id, const char * key )
+{
+    hash_t needle_hash = CharMapHashString( id, key );
+    CharMapEntry * entry = CharMapHashFindEntry( id, key, needle_hash );
+    if ( !entry->key.string )
+    {
+        entry->key.string = ( char * )( malloc( strlen( key ) + 1 ) );
+        strcpy( entry->key.string, key );
+        entry->key.hash = needle_hash;
+    }
+    return entry;
+};
+
+static CharMapEntry * CharMapHashFindEntry( unsigned int id, const char * needle_string, hash_t needle_hash )
+{
+    while ( 1 )
+    {
+        CharMapEntry * entry = &charmaps.list[ id ].list[ needle_hash ];
+        if ( entry->key.string == NULL || strcmp( entry->key.string, needle_string ) == 0 )
+        {
+            return entry;
+        }
+        needle_hash = ( needle_hash + 1 ) % charmaps.list[ id ].hashmax;
+    }
+};
+
+static uint32_t CharMapHashString( unsigned int id, const char * key )
+{
+    return NasrHashString( key, charmaps.list[ id ].hashmax );
+};
+
+static void CharsetMalformedError( const char * msg, const char * file )
+{
+    NasrLog( "NasrAddCharset Error: Charset file “%s” malformed: “%s”.", file, msg );
+};
+
+static int CheckTextureUnpacked( const char * caller, unsigned int texture )
+{
+    // Tilemap shaders sample tileset as plain 2D texture o’ its own.
+    if ( texture < texture_count && textures[ texture ].atlas )
+    {
+        NasrLog( "%s Error: texture #%u is packed into atlas & can’t be used here.", caller, texture );
+        return -1;
+    }
+    if ( texture < texture_count && textures[ texture ].layered )
+    {
+        NasrLog( "%s Error: texture #%u is layer o’ texture array & can’t be used here.", caller, texture );
+        return -1;
+    }
+    return 0;
+};
+
+static void ClearBufferBindings( void )
+{
+    glBindVertexArray( 0 );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+};
+
+static void ClearTileAnimations( Texture * texture )
+{
+    if ( texture->animations )
+    {
+        glDeleteTextures( 1, &texture->animations->texture );
+        free( texture->animations->list );
+        free( texture->animations );
+        texture->animations = 0;
+    }
+};
+
+static void ClearTilemapBake( NasrGraphicTilemap * tilemap )
+{
+    if ( tilemap->bake_textures )
+    {
+        glDeleteTextures( tilemap->bake_chunksw * tilemap->bake_chunksh, tilemap->bake_textures );
+        free( tilemap->bake_textures );
+        tilemap->bake_textures = 0;
+    }
+    free( tilemap->bake_stale );
+    tilemap->bake_stale = 0;
+};
+
+static unsigned int CountTilemapSolidBits( const uint64_t * row, int x, int w )
+{
+    // Count whole 64-tile words @ once, masking off bits outside range in 1st & last words.
+    unsigned int count = 0;
+    const int last = x + w - 1;
+    for ( int word = x / 64; word <= last / 64; ++word )
+    {
+        uint64_t bits = row[ word ];
+        if ( word == x / 64 )
+        {
+            bits &= ~( uint64_t )( 0 ) << ( x % 64 );
+        }
+        if ( word == last / 64 && last % 64 < 63 )
+        {
+            bits &= ( ( uint64_t )( 1 ) << ( last % 64 + 1 ) ) - 1;
+        }
+        #if defined( __GNUC__ )
+            count += ( unsigned int )( __builtin_popcountll( bits ) );
+        #else
+            for ( ; bits; bits &= bits - 1 )
+            {
+                ++count;
+            }
+        #endif
+    }
+    return count;
+};
+
+static GLuint CreateTextureArray( unsigned int width, unsigned int height, unsigned int layers, GLint sampling, GLint indexed )
+{
+    GLuint id;
+    glGenTextures( 1, &id );
+    glBindTexture( GL_TEXTURE_2D_ARRAY, id );
+    glTexImage3D( GL_TEXTURE_2D_ARRAY, 0, indexed, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0 );
+    glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT );
+    SetTextureFilters( GL_TEXTURE_2D_ARRAY, sampling, TextureMipmapped( sampling, indexed ) );
+    ResetTextureBindings();
+    texture_bytes += ( uint64_t )( width ) * height * layers * ( indexed == GL_R8 ? 1 : 4 );
+    return id;
+};
+
+static void DestroyGraphic( NasrGraphic * graphic )
+{
+    switch ( graphic->type )
+    {
+        case ( NASR_GRAPHIC_TEXT ):
+        {
+            if ( graphic->data.text.vaos )
+            {
+                glDeleteVertexArrays( graphic->data.text.capacity, graphic->data.text.vaos );
+                free( graphic->data.text.vaos );
+            }
+            if ( graphic->data.text.vbos )
+            {
+                glDeleteRenderbuffers( graphic->data.text.capacity, graphic->data.text.vbos );
+                free( graphic->data.text.vbos );
+            }
+            free( graphic->data.text.vertices );
+            free( graphic->data.text.chars );
+            graphic->type = NASR_GRAPHIC_NONE;
+        }
+        break;
+        case ( NASR_GRAPHIC_COUNTER ):
+        {
+            if ( graphic->data.counter )
+            {
+                glDeleteVertexArrays( 1, &graphic->data.counter->vao );
+                glDeleteBuffers( 1, &graphic->data.counter->vbo );
+                free( graphic->data.counter );
+            }
+            graphic->type = NASR_GRAPHIC_NONE;
+        }
+        break;
+        case ( NASR_GRAPHIC_TILEMAP_CHUNKED ):
+        {
+            if ( graphic->data.chunked )
+            {
+                DestroyChunkedTilemap( graphic->data.chunked );
+            }
+            graphic->type = NASR_GRAPHIC_NONE;
+        }
+        break;
+        case ( NASR_GRAPHIC_TILEMAP_LAYERED ):
+        {
+            if ( graphic->data.layered )
+            {
+                glDeleteTextures( 1, &graphic->data.layered->maps );
+                free( graphic->data.layered->data );
+                free( graphic->data.layered );
+            }
+            graphic->type = NASR_GRAPHIC_NONE;
+        }
+        break;
+        case ( NASR_GRAPHIC_TEXT_STREAM ):
+        {
+            if ( graphic->data.stream )
+            {
+                glDeleteVertexArrays( 1, &graphic->data.stream->vao );
+                glDeleteBuffers( 1, &graphic->data.stream->vbo );
+                glDeleteBuffers( 1, &graphic->data.stream->ebo );
+                free( graphic->data.stream->string );
+                free( graphic->data.stream->lines );
+                free( graphic->data.stream->slot_lines );
+                free( graphic->data.stream->vertices );
+                free( graphic->data.stream );
+            }
+            graphic->type = NASR_GRAPHIC_NONE;
+        }
+        break;
+        case ( NASR_GRAPHIC_TILEMAP ):
+        {
+            if ( graphic->data.tilemap.data )
+            {
+                free( graphic->data.tilemap.data );
+            }
+            free( graphic->data.tilemap.solid );
+            free( graphic->data.tilemap.solid_rows );
+            ClearTilemapBake( &graphic->data.tilemap );
+            if ( textures[ graphic->data.tilemap.tilemap ].owned )
+            {
+                ReleaseTextureSlot( graphic->data.tilemap.tilemap );
+            }
+            graphic->type = NASR_GRAPHIC_NONE;
+        }
+        break;
+    }
+};
+
+static int DrawBakedTilemap( NasrGraphicTilemap * tilemap, unsigned int vao, float scrollx, float scrolly )
+{
+    // Only maps that look the same every frame can be baked; anything else falls back to tilemap shader.
+    if ( tilemap->bake_check )
+    {
+        tilemap->bake_ok = !TilemapHasAnimatedTiles( tilemap );
+        tilemap->bake_check = 0;
+    }
+    if ( !tilemap->bake_ok || tilemap->useglobalpal || tilemap->tilingx != 1.0f || tilemap->tilingy != 1.0f )
+    {
+        return -1;
+    }
+
+    // Don’t bake tileset’s placeholder while real pixels are still on their way.
+    const Texture * tileset = &textures[ tilemap->texture ];
+    if ( tileset->loading || tileset->evicted )
+    {
+        return -1;
+    }
+
+    const unsigned int chunk_count = tilemap->bake_chunksw * tilemap->bake_chunksh;
+    if ( !tilemap->bake_textures )
+    {
+        tilemap->bake_textures = calloc( chunk_count, sizeof( GLuint ) );
+        tilemap->bake_stale = malloc( chunk_count * sizeof( uint_fast8_t ) );
+        if ( !tilemap->bake_textures || !tilemap->bake_stale )
+        {
+            NasrLog( "DrawBakedTilemap Error: ¡Not ’nough memory for baked tilemap!" );
+            ClearTilemapBake( tilemap );
+            tilemap->bake = 0;
+            return -1;
+        }
+        memset( tilemap->bake_stale, 1, chunk_count * sizeof( uint_fast8_t ) );
+        tilemap->bake_palette = palette_version;
+        tilemap->bake_texture_version = tileset->version;
+    }
+    if ( tilemap->bake_palette != palette_version || tilemap->bake_texture_version != tileset->version )
+    {
+        memset( tilemap->bake_stale, 1, chunk_count * sizeof( uint_fast8_t ) );
+        tilemap->bake_palette = palette_version;
+        tilemap->bake_texture_version = tileset->version;
+    }
+
+    // Find range o’ chunks on screen.
+    const float viewx = camera.x * ( 1.0f - scrollx ) - tilemap->dest.x;
+    const float viewy = camera.y * ( 1.0f - scrolly ) - tilemap->dest.y;
+    const int left = NASR_MATH_MAX( ( int )( floorf( viewx / TILEMAP_BAKE_SIZE ) ), 0 );
+    const int right = NASR_MATH_MIN( ( int )( floorf( ( viewx + canvas.w ) / TILEMAP_BAKE_SIZE ) ), ( int )( tilemap->bake_chunksw ) - 1 );
+    const int top = NASR_MATH_MAX( ( int )( floorf( viewy / TILEMAP_BAKE_SIZE ) ), 0 );
+    const int bottom = NASR_MATH_MIN( ( int )( floorf( ( viewy + canvas.h ) / TILEMAP_BAKE_SIZE ) ), ( int )( tilemap->bake_chunksh ) - 1 );
+
+    // Rebake stale chunks before switching to sprite shader.
+    for ( int cy = top; cy <= bottom; ++cy )
+    {
+        for ( int cx = left; cx <= right; ++cx )
+        {
+            const unsigned int chunk = cy * tilemap->bake_chunksw + cx;
+            if ( tilemap->bake_stale[ chunk ] )
+            {
+                BakeTilemapChunk( tilemap, vao, chunk );
+            }
+        }
+    }
+
+    SetShader( sprite_shader );
+    glUniform1f( sprite_uniforms.opacity, tilemap->opacity );
+    glUniform2f( sprite_uniforms.tiling, 1.0f, 1.0f );
+    glUniform4f( sprite_uniforms.atlas_rect, 0.0f, 0.0f, 0.0f, 0.0f );
+    mat4 model = BASE_MATRIX;
+    vec3 scale = { TILEMAP_BAKE_SIZE, TILEMAP_BAKE_SIZE, 0.0 };
+    glm_scale( model, scale );
+    glUniformMatrix4fv( sprite_uniforms.model, 1, GL_FALSE, ( float * )( model ) );
+    for ( int cy = top; cy <= bottom; ++cy )
+    {
+        for ( int cx = left; cx <= right; ++cx )
+        {
+            BindTexture( 0, tilemap->bake_textures[ cy * tilemap->bake_chunksw + cx ] );
+            glUniform1i( sprite_uniforms.texture_data, 0 );
+            SetVerticesView
+            (
+                tilemap->dest.x + ( float )( cx * TILEMAP_BAKE_SIZE ) + ( TILEMAP_BAKE_SIZE / 2.0f ),
+                tilemap->dest.y + ( float )( cy * TILEMAP_BAKE_SIZE ) + ( TILEMAP_BAKE_SIZE / 2.0f ),
+                scrollx,
+                scrolly
+            );
+            SetupVertices( vao );
+        }
+    }
+    return 0;
+};
+
+static void DrawBox( unsigned int vao, const NasrRect * rect, float scrollx, float scrolly )
+{
+    // Set shader.
+    SetShader( rect_shader );
+
+    // Set view.
+    SetVerticesView( rect->x + ( rect->w / 2.0f ), rect->y + ( rect->h / 2.0f ), scrollx, scrolly );
+
+    // Set scale.
+    mat4 model = BASE_MATRIX;
+    vec3 scale = { rect->w, rect->h, 0.0 };
+    glm_scale( model, scale );
+    glUniformMatrix4fv( rect_uniforms.model, 1, GL_FALSE, ( float * )( model ) );
+};
+
+static void DestroyChunkedTilemap( NasrGraphicChunkedTilemap * tilemap )
+{
+    if ( tilemap->chunks )
+    {
+        for ( size_t i = 0; i < ( size_t )( tilemap->chunksw ) * tilemap->chunksh; ++i )
+        {
+            free( tilemap->chunks[ i ] );
+        }
+        free( tilemap->chunks );
+    }
+    if ( tilemap->slot_textures )
+    {
+        glDeleteTextures( tilemap->slot_count, tilemap->slot_textures );
+        free( tilemap->slot_textures );
+    }
+    free( tilemap->chunk_slots );
+    free( tilemap->slot_chunks );
+    free( tilemap->slot_used );
+    free( tilemap->slot_dirty );
+    free( tilemap );
+};
+
+static void DistanceTransform( float * grid, unsigned int width, unsigned int height )
+{
+    // Separable squared distance transform: run 1D pass down every column, then along every row.
+    const unsigned int n = NASR_MATH_MAX( width, height );
+    float * f = malloc( n * sizeof( float ) );
+    float * d = malloc( n * sizeof( float ) );
+    int * v = malloc( n * sizeof( int ) );
+    float * z = malloc( ( n + 1 ) * sizeof( float ) );
+    if ( !f || !d || !v || !z )
+    {
+        NasrLog( "DistanceTransform Error: ¡Not ’nough memory for distance field!" );
+        free( f );
+        free( d );
+        free( v );
+        free( z );
+        return;
+    }
+
+    for ( unsigned int x = 0; x < width; ++x )
+    {
+        for ( unsigned int y = 0; y < height; ++y )
+        {
+            f[ y ] = grid[ y * width + x ];
+        }
+        DistanceTransformLine( f, d, v, z, height );
+        for ( unsigned int y = 0; y < height; ++y )
+        {
+            grid[ y * width + x ] = d[ y ];
+        }
+    }
+
+    for ( unsigned int y = 0; y < height; ++y )
+    {
+        memcpy( f, &grid[ y * width ], width * sizeof( float ) );
+        DistanceTransformLine( f, &grid[ y * width ], v, z, width );
+    }
+
+    free( f );
+    free( d );
+    free( v );
+    free( z );
+};
+
+static void DistanceTransformLine( const float * f, float * d, int * v, float * z, unsigned int n )
+{
+    // Lower envelope o’ parabolas rooted @ each sample, as in Felzenszwalb & Huttenlocher.
+    const float inf = 1e20f;
+    int k = 0;
+    v[ 0 ] = 0;
+    z[ 0 ] = -inf;
+    z[ 1 ] = inf;
+    for ( int q = 1; q < ( int )( n ); ++q )
+    {
+        float s = ( ( f[ q ] + ( float )( q * q ) ) - ( f[ v[ k ] ] + ( float )( v[ k ] * v[ k ] ) ) ) / ( float )( 2 * q - 2 * v[ k ] );
+        while ( s <= z[ k ] )
+        {
+            --k;
+            s = ( ( f[ q ] + ( float )( q * q ) ) - ( f[ v[ k ] ] + ( float )( v[ k ] * v[ k ] ) ) ) / ( float )( 2 * q - 2 * v[ k ] );
+        }
+        ++k;
+        v[ k ] = q;
+        z[ k ] = s;
+        z[ k + 1 ] = inf;
+    }
+
+    k = 0;
+    for ( int q = 0; q < ( int )( n ); ++q )
+    {
+        while ( z[ k + 1 ] < ( float )( q ) )
+        {
+            ++k;
+        }
+        d[ q ] = ( float )( ( q - v[ k ] ) * ( q - v[ k ] ) ) + f[ v[ k ] ];
+    }
+};
+
+static void DrawChunkedTilemap( NasrGraphicChunkedTilemap * tilemap, const TilemapUniforms * uniforms, unsigned int vao, float scrollx, float scrolly )
+{
+    ++tilemap->frame;
+
+    // Find range o’ chunks on screen.
+    const float viewx = camera.x * ( 1.0f - scrollx ) - tilemap->x;
+    const float viewy = camera.y * ( 1.0f - scrolly ) - tilemap->y;
+    const int left = ( int )( floorf( viewx / TILEMAP_CHUNK_PIXELS ) );
+    const int right = ( int )( floorf( ( viewx + camera.w ) / TILEMAP_CHUNK_PIXELS ) );
+    const int top = ( int )( floorf( viewy / TILEMAP_CHUNK_PIXELS ) );
+    const int bottom = ( int )( floorf( ( viewy + camera.h ) / TILEMAP_CHUNK_PIXELS ) );
+
+    // 1st pass draws chunks on screen; 2nd streams in chunks 1 past screen’s edges so they’re ready
+    // before camera reaches them. Chunks neither pass touches are 1st to be evicted.
+    for ( int pass = 0; pass < 2; ++pass )
+    {
+        const int margin = pass;
+        for ( int cy = NASR_MATH_MAX( top - margin, 0 ); cy <= NASR_MATH_MIN( bottom + margin, ( int )( tilemap->chunksh ) - 1 ); ++cy )
+        {
+            for ( int cx = NASR_MATH_MAX( left - margin, 0 ); cx <= NASR_MATH_MIN( right + margin, ( int )( tilemap->chunksw ) - 1 ); ++cx )
+            {
+                const uint_fast8_t visible = cx >= left && cx <= right && cy >= top && cy <= bottom;
+                if ( pass && visible )
+                {
+                    continue;
+                }
+
+                const unsigned int c = ( unsigned int )( cy ) * tilemap->chunksw + ( unsigned int )( cx );
+                if ( !tilemap->chunks[ c ] )
+                {
+                    continue;
+                }
+
+                int slot = tilemap->chunk_slots[ c ];
+                if ( slot < 0 )
+                {
+                    // Take empty slot or slot least recently used.
+                    for ( unsigned int s = 0; s < tilemap->slot_count; ++s )
+                    {
+                        if ( tilemap->slot_chunks[ s ] < 0 )
+                        {
+                            slot = s;
+                            break;
+                        }
+                        if ( tilemap->slot_used[ s ] != tilemap->frame && ( slot < 0 || tilemap->slot_used[ s ] < tilemap->slot_used[ slot ] ) )
+                        {
+                            slot = s;
+                        }
+                    }
+                    if ( slot < 0 )
+                    {
+                        continue;
+                    }
+                    if ( tilemap->slot_chunks[ slot ] >= 0 )
+                    {
+                        tilemap->chunk_slots[ tilemap->slot_chunks[ slot ] ] = -1;
+                    }
+                    tilemap->slot_chunks[ slot ] = c;
+                    tilemap->chunk_slots[ c ] = slot;
+                    tilemap->slot_dirty[ slot ] = 1;
+                }
+
+                if ( tilemap->slot_dirty[ slot ] )
+                {
+                    glActiveTexture( GL_TEXTURE2 );
+                    BindTexture( 2, tilemap->slot_textures[ slot ] );
+                    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TILEMAP_CHUNK_SIZE, TILEMAP_CHUNK_SIZE, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, tilemap->chunks[ c ] );
+                    tilemap->slot_dirty[ slot ] = 0;
+                }
+                tilemap->slot_used[ slot ] = tilemap->frame;
+
+                if ( visible )
+                {
+                    SetVerticesView
+                    (
+                        tilemap->x + ( float )( cx ) * TILEMAP_CHUNK_PIXELS + ( TILEMAP_CHUNK_PIXELS / 2.0f ),
+                        tilemap->y + ( float )( cy ) * TILEMAP_CHUNK_PIXELS + ( TILEMAP_CHUNK_PIXELS / 2.0f ),
+                        scrollx,
+                        scrolly
+                    );
+                    BindTexture( 2, tilemap->slot_textures[ slot ] );
+                    glUniform1i( uniforms->mapdata, 2 );
+                    SetupVertices( vao );
+                }
+            }
+        }
+    }
+};
+
+static void DrawTextStream( NasrGraphicTextStream * stream )
+{
+    if ( !stream->line_count )
+    {
+        return;
+    }
+
+    // Find 1st line reaching into box; lines are sorted by y, so binary search.
+    const float top = stream->coords.y + stream->scroll;
+    const float bottom = top + stream->coords.h;
+    unsigned int first = 0;
+    unsigned int last = stream->line_count;
+    while ( first < last )
+    {
+        const unsigned int middle = first + ( last - first ) / 2;
+        if ( stream->lines[ middle ].y + stream->lines[ middle ].height <= top )
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    // Walk window o’ lines from there: visible lines get uploaded 1st, then lines below are
+    // laid out ahead o’ time with whatever budget is left.
+    unsigned int budget = stream->budget;
+    const unsigned int end = NASR_MATH_MIN( first + stream->window_lines, stream->line_count );
+    for ( unsigned int l = first; l < end; ++l )
+    {
+        const TextStreamLine * line = &stream->lines[ l ];
+        const uint_fast8_t visible = line->y < bottom;
+        const unsigned int slot = l % stream->window_lines;
+        if ( stream->slot_lines[ slot ] != ( int )( l ) )
+        {
+            // Always let 1 line through so lines longer than budget still show up.
+            if ( line->glyphs > budget && budget < stream->budget )
+            {
+                if ( visible )
+                {
+                    continue;
+                }
+                break;
+            }
+            UploadTextStreamLine( stream, l, slot );
+            budget -= NASR_MATH_MIN( line->glyphs, budget );
+        }
+
+        if ( visible && line->glyphs && line->first < stream->count )
+        {
+            const unsigned int n = NASR_MATH_MIN( line->glyphs, stream->count - line->first );
+            glDrawElementsBaseVertex( GL_TRIANGLES, n * 6, GL_UNSIGNED_INT, 0, slot * stream->max_line_glyphs * 4 );
+        }
+    }
+};
+
+static void EvictTextures( void )
+{
+    // Drop least-recently-used file textures down to blank placeholders till back under budget.
+    while ( texture_budget > 0 && texture_bytes > texture_budget )
+    {
+        int lru = -1;
+        for ( int i = 0; i < texture_count; ++i )
+        {
+            const Texture * texture = &textures[ i ];
+            if
+            (
+                texture->evictable
+                && !texture->evicted
+                && !texture->loading
+                && texture->last_used != texture_frame
+                && ( lru < 0 || texture->last_used < textures[ lru ].last_used )
+            )
+            {
+                lru = i;
+            }
+        }
+        if ( lru < 0 )
+        {
+            break;
+        }
+
+        // Keep width & height so sprites’ texture coords stay right for when it’s reloaded.
+        // Swap in fresh texture object so every mip level gets freed, not just base.
+        Texture * texture = &textures[ lru ];
+        const unsigned char placeholder[ 4 ] = { 0, 0, 0, 0 };
+        glDeleteTextures( 1, &texture_ids[ lru ] );
+        glGenTextures( 1, &texture_ids[ lru ] );
+        glBindTexture( GL_TEXTURE_2D, texture_ids[ lru ] );
+        glTexImage2D( GL_TEXTURE_2D, 0, texture->indexed ? GL_R8 : GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0 );
+        texture_bytes -= texture->bytes;
+        texture->bytes = 0;
+        texture->evicted = 1;
+        ++texture->version;
+    }
+    ResetTextureBindings();
+};
+
+static void FillVerticesColorValues( float * vptr, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color )
+{
+    vptr[ 4 ] = bottom_right_color->r / 255.0f;
+    vptr[ 5 ] = bottom_right_color->g / 255.0f;
+    vptr[ 6 ] = bottom_right_color->b / 255.0f;
+    vptr[ 7 ] = bottom_right_color->a / 255.0f;
+
+    vptr[ 4 + VERTEX_SIZE ] = top_right_color->r / 255.0f;
+    vptr[ 5 + VERTEX_SIZE ] = top_right_color->g / 255.0f;
+    vptr[ 6 + VERTEX_SIZE ] = top_right_color->b / 255.0f;
+    vptr[ 7 + VERTEX_SIZE ] = top_right_color->a / 255.0f;
+
+    vptr[ 4 + VERTEX_SIZE * 2 ] = top_left_color->r / 255.0f;
+    vptr[ 5 + VERTEX_SIZE * 2 ] = top_left_color->g / 255.0f;
+    vptr[ 6 + VERTEX_SIZE * 2 ] = top_left_color->b / 255.0f;
+    vptr[ 7 + VERTEX_SIZE * 2 ] = top_left_color->a / 255.0f;
+
+    vptr[ 4 + VERTEX_SIZE * 3 ] = bottom_left_color->r / 255.0f;
+    vptr[ 5 + VERTEX_SIZE * 3 ] = bottom_left_color->g / 255.0f;
+    vptr[ 6 + VERTEX_SIZE * 3 ] = bottom_left_color->b / 255.0f;
+    vptr[ 7 + VERTEX_SIZE * 3 ] = bottom_left_color->a / 255.0f;
+};
+
+static const CharTemplate * FindCharTemplate( unsigned int charset, const char * s, int * len )
+{
+    *len = GetCharacterSize( s );
+    char letter[ *len + 1 ];
+    strncpy( letter, s, *len );
+    letter[ *len ] = 0;
+
+    CharMapEntry * entry = CharMapHashFindEntry( charset, letter, CharMapHashString( charset, letter ) );
+    if ( entry->key.string == NULL )
+    {
+        entry = CharMapHashFindEntry( charset, "default", CharMapHashString( charset, "default" ) );
+    }
+    return entry->key.string ? &entry->value : 0;
+};
+
+static void FinishTextureLoads( void )
+{
+    if ( !texture_loader.running )
+    {
+        return;
+    }
+
+    // Upload decoded textures till this frame’s budget is used up; always do @ least 1 so big textures can’t stall queue.
+    unsigned int uploaded = 0;
+    do
+    {
+        pthread_mutex_lock( &texture_loader.lock );
+        TextureLoadJob * job = texture_loader.done;
+        if ( job )
+        {
+            texture_loader.done = job->next;
+            if ( !texture_loader.done )
+            {
+                texture_loader.done_tail = 0;
+            }
+        }
+        pthread_mutex_unlock( &texture_loader.lock );
+        if ( !job )
+        {
+            break;
+        }
+
+        if ( job->generation == texture_generation )
+        {
+            Texture * texture = &textures[ job->texture ];
+            if ( job->data )
+            {
+                const unsigned int channels = GetTextureChannels( job->indexed );
+                AddTexture( texture, texture_ids[ job->texture ], job->data, job->width, job->height, job->sampling, job->indexed, channels );
+                RefreshSpritesForTexture( job->texture );
+                uploaded += job->width * job->height * channels;
+            }
+            else
+            {
+                NasrLog( "NasrLoadFileAsTextureAsync Error: could not load data from “%s”.", job->filename );
+                texture->loading = 0;
+                texture->failed = 1;
+
+                // Don’t keep retrying file that’s gone.
+                texture->evictable = 0;
+                texture->evicted = 0;
+            }
+            if ( job->callback )
+            {
+                job->callback( ( int )( job->texture ), job->data != 0 );
+            }
+        }
+        free( job->data );
+        free( job->filename );
+        free( job );
+    }
+    while ( uploaded < texture_loader.budget );
+
+    // Let anyone waiting on texture that’s now ready know.
+    TextureLoadJob ** waiter = &texture_loader.waiters;
+    while ( *waiter )
+    {
+        TextureLoadJob * job = *waiter;
+        if ( textures[ job->texture ].loading )
+        {
+            waiter = &job->next;
+            continue;
+        }
+        *waiter = job->next;
+        if ( job->callback )
+        {
+            job->callback( ( int )( job->texture ), !textures[ job->texture ].failed );
+        }
+        free( job );
+    }
+};
+
+static void FlushLayeredTilemap( NasrGraphicLayeredTilemap * tilemap )
+{
+    if ( !tilemap->dirty_layers )
+    {
+        return;
+    }
+
+    // Upload each layer’s dirty rect straight out o’ full map data.
+    glActiveTexture( GL_TEXTURE2 );
+    glBindTexture( GL_TEXTURE_2D_ARRAY, tilemap->maps );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, tilemap->w );
+    for ( unsigned int l = 0; l < tilemap->layer_count; ++l )
+    {
+        if ( !( tilemap->dirty_layers & ( 1 << l ) ) )
+        {
+            continue;
+        }
+        const NasrRectInt * r = &tilemap->dirty[ l ];
+        glTexSubImage3D
+        (
+            GL_TEXTURE_2D_ARRAY,
+            0,
+            r->x,
+            r->y,
+            l,
+            r->w,
+            r->h,
+            1,
+            GL_RGBA_INTEGER,
+            GL_UNSIGNED_BYTE,
+            &tilemap->data[ ( ( ( size_t )( l ) * tilemap->h + r->y ) * tilemap->w + r->x ) * 4 ]
+        );
+    }
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+    tilemap->dirty_layers = 0;
+};
+
+static void FlushTilemap( NasrGraphicTilemap * tilemap )
+{
+    if ( !tilemap->dirty_count )
+    {
+        return;
+    }
+
+    // Upload only dirty rects, reading them straight out o’ full map data by telling GL its row length.
+    glActiveTexture( GL_TEXTURE2 );
+    BindTexture( 2, texture_ids[ tilemap->tilemap ] );
+    const unsigned int width = textures[ tilemap->tilemap ].width;
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, width );
+    for ( uint_fast8_t i = 0; i < tilemap->dirty_count; ++i )
+    {
+        const NasrRectInt * r = &tilemap->dirty[ i ];
+        glTexSubImage2D
+        (
+            GL_TEXTURE_2D,
+            0,
+            r->x,
+            r->y,
+            r->w,
+            r->h,
+            GL_RGBA_INTEGER,
+            GL_UNSIGNED_BYTE,
+            &tilemap->data[ ( ( size_t )( r->y ) * width + r->x ) * 4 ]
+        );
+    }
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+    tilemap->dirty_count = 0;
+};
+
+static void FramebufferSizeCallback( GLFWwindow * window, int screen_width, int screen_height )
+{
+    double screen_aspect_ratio = ( double )( canvas.w / canvas.h );
+    double monitor_aspect_ratio = ( double )( screen_width ) / ( double )( screen_height );
+
+    // Base magnification on max that fits in window.
+    magnification = 
+        ( int )( floor(
+            ( monitor_aspect_ratio > screen_aspect_ratio )
+                ? ( double )( screen_height ) / ( double )( canvas.h )
+                : ( double )( screen_width ) / ( double )( canvas.w )
+        ));
+    if ( magnification < 1 )
+    {
+        magnification = 1;
+    }
+
+    magnified_canvas_width = canvas.w * magnification;
+    magnified_canvas_height = canvas.h * magnification;
+    magnified_canvas_x = ( int )( floor( ( double )( screen_width - magnified_canvas_width ) / 2.0 ) );
+    magnified_canvas_y = ( int )( floor( ( double )( screen_height - magnified_canvas_height ) / 2.0 ) );
+    glViewport( magnified_canvas_x, magnified_canvas_y, magnified_canvas_width, magnified_canvas_height );
+};
+
+static void GenerateCharsetDigitTable( unsigned int id )
+{
+    #define CM charmaps.list[ id ]
+    for ( int i = 0; i < 11; ++i )
+    {
+        CM.numsrc[ i * 4 ] = CM.nums[ i ].src.x / ( float )( CM.texture.width );
+        CM.numsrc[ i * 4 + 1 ] = CM.nums[ i ].src.y / ( float )( CM.texture.height );
+        CM.numsrc[ i * 4 + 2 ] = CM.nums[ i ].src.w / ( float )( CM.texture.width );
+        CM.numsrc[ i * 4 + 3 ] = CM.nums[ i ].src.h / ( float )( CM.texture.height );
+        CM.numdest[ i * 4 ] = CM.nums[ i ].xoffset;
+        CM.numdest[ i * 4 + 1 ] = CM.nums[ i ].yoffset;
+        CM.numdest[ i * 4 + 2 ] = CM.nums[ i ].src.w;
+        CM.numdest[ i * 4 + 3 ] = CM.nums[ i ].src.h;
+    }
+
+    // Blank entry for unpadded digits is just an empty quad.
+    memset( &CM.numsrc[ COUNTER_BLANK * 4 ], 0, sizeof( float ) * 4 );
+    memset( &CM.numdest[ COUNTER_BLANK * 4 ], 0, sizeof( float ) * 4 );
+    #undef CM
+};
+
+static void GenerateDistanceField( unsigned char * data, unsigned int width, unsigned int height )
+{
+    // Only full-brightness pixels count as glyph body; darker pixels are baked-in shadow, which
+    // SDF shaders redraw themselves from offset body.
+    const size_t size = ( size_t )( width ) * ( size_t )( height );
+    float * outside = malloc( size * sizeof( float ) );
+    float * inside = malloc( size * sizeof( float ) );
+    if ( !outside || !inside )
+    {
+        NasrLog( "GenerateDistanceField Error: ¡Not ’nough memory for distance field!" );
+        free( outside );
+        free( inside );
+        return;
+    }
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const uint_fast8_t body = data[ i * 4 + 3 ] >= 128 && data[ i * 4 ] == 255;
+        outside[ i ] = body ? 0.0f : 1e20f;
+        inside[ i ] = body ? 1e20f : 0.0f;
+    }
+    DistanceTransform( outside, width, height );
+    DistanceTransform( inside, width, height );
+
+    // Store signed distance to edge ( halfway ’tween pixel centers ) in alpha, mapped so 0.5 is edge.
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const float d = inside[ i ] > 0.0f
+            ? sqrtf( inside[ i ] ) - 0.5f
+            : 0.5f - sqrtf( outside[ i ] );
+        const float v = NASR_MATH_MIN( NASR_MATH_MAX( 0.5f + d / ( 2.0f * SDF_SPREAD ), 0.0f ), 1.0f );
+        data[ i * 4 ] = data[ i * 4 + 1 ] = data[ i * 4 + 2 ] = 255;
+        data[ i * 4 + 3 ] = ( unsigned char )( v * 255.0f + 0.5f );
+    }
+
+    free( outside );
+    free( inside );
+};
+
+static unsigned int GenerateShaderProgram( const NasrShader * shaders, int shadersnum )
+{
+    unsigned int program = glCreateProgram();
+    unsigned int shader_ids[ shadersnum ];
+
+    // Compile each shader and attach to program
+    for ( int i = 0; i < shadersnum; ++i )
+    {
+        int success;
+        char infoLog[ 512 ];
+
+        GLenum type;
+        switch ( shaders[ i ].type )
+        {
+            case ( NASR_SHADER_VERTEX ):
+            {
+                type = GL_VERTEX_SHADER;
+            }
+            break;
+            case ( NASR_SHADER_FRAGMENT ):
+            {
+                type = GL_FRAGMENT_SHADER;
+            }
+            break;
+            default:
+            {
+                NasrLog( "Invalid shader type given to shader!" );
+            }
+            break;
+        }
+
+        shader_ids[ i ] = glCreateShader( type );
+        glShaderSource( shader_ids[ i ], 1, ( const GLchar * const * )( &shaders[ i ].code ), NULL );
+        glCompileShader( shader_ids[ i ] );
+        glGetShaderiv( shader_ids[ i ], GL_COMPILE_STATUS, &success );
+        if ( !success )
+        {
+            glGetShaderInfoLog( shader_ids[ i ], 512, NULL, infoLog );
+            NasrLog( "ERROR::SHADER::VERTEX::COMPILATION_FAILED." );
+            NasrLog( infoLog );
+        }
+        glAttachShader( program, shader_ids[ i ] );
+    }
+
+    glLinkProgram( program );
+
+    // If there are any errors, log them
+    int  success;
+    char infoLog[ 512 ];
+    glGetProgramiv( program, GL_LINK_STATUS, &success );
+    if( !success )
+    {
+        glGetProgramInfoLog( program, 512, NULL, infoLog );
+        NasrLog( "ERROR: Failed to create shader program." );
+        NasrLog( infoLog );
+    }
+
+    // Delete shaders
+    for ( int i = 0; i < shadersnum; ++i )
+    {
+        glDeleteShader( shader_ids[ i ] );
+    }
+
+    return program;
+};
+
+static int GetCharacterSize( const char * s )
+{
+    const int code = ( int )( *s );
+    return ( code & ( 1 << 7 ) )
+        ? ( code & ( 1 << 5 ) )
+            ? ( code & ( 1 << 4 ) )
+                ? 4
+                : 3
+            : 2
+        : 1;
+};
+
+static const CounterUniforms * GetCounterShader( const NasrGraphicCounter * counter, unsigned int * shader )
+{
+    if ( charmaps.list[ counter->charset ].type == NASR_CHARSET_SDF )
+    {
+        *shader = counter->palette_type ? counter_sdf_pal_shader : counter_sdf_shader;
+        return counter->palette_type ? &counter_sdf_pal_uniforms : &counter_sdf_uniforms;
+    }
+    *shader = counter->palette_type ? counter_pal_shader : counter_shader;
+    return counter->palette_type ? &counter_pal_uniforms : &counter_uniforms;
+};
+
+static GLint GetGLRGBA( int indexed )
+{
+    switch ( indexed )
+    {
+        case ( NASR_INDEXED_YES ): return GL_R8;
+        case ( NASR_INDEXED_NO ): return GL_RGBA;
+        default: return default_indexed_mode;
+    }
+};
+
+static GLint GetGLSamplingType( int sampling )
+{
+    switch ( sampling )
+    {
+        case ( NASR_SAMPLING_NEAREST ): return GL_NEAREST;
+        case ( NASR_SAMPLING_LINEAR ): return GL_LINEAR;
+        case ( NASR_SAMPLING_MIPMAP ): return GL_LINEAR_MIPMAP_LINEAR;
+        default: return default_sample_type;
+    }
+};
 
 static NasrGraphic * GetGraphic( unsigned int id )
 {
-    return &graphics[ gfx_ptrs_id_to_pos[ id ] ];
+    return &graphics[ gfx_ptrs_id_to_pos[ id ] ];
+};
+
+static void GetSpriteTextureCoords( const NasrGraphicSprite * sprite, float * left, float * right, float * top, float * bottom )
+{
+    // Atlas textures’ src rects are relative to their own image, so shift them to where it sits in its page.
+    const Texture * texture = &textures[ sprite->texture ];
+    const Texture * storage = &textures[ GetTextureStorage( sprite->texture ) ];
+    const float x = sprite->src.x + ( texture->atlas ? ( float )( texture->atlas_x ) : 0.0f );
+    const float y = sprite->src.y + ( texture->atlas ? ( float )( texture->atlas_y ) : 0.0f );
+    *left = 1.0f / ( float )( storage->width ) * x;
+    *right = 1.0f / ( float )( storage->width ) * ( x + sprite->src.w );
+    *top = 1.0f / ( float )( storage->height ) * y;
+    *bottom = 1.0f / ( float )( storage->height ) * ( y + sprite->src.h );
+};
+
+static unsigned int GetStateLayerIndex( unsigned int state, unsigned int layer )
+{
+    return state * max_gfx_layers + layer;
+};
+
+static const TextUniforms * GetTextShader( unsigned int charset, uint_fast8_t palette_type, unsigned int * shader )
+{
+    if ( charmaps.list[ charset ].type == NASR_CHARSET_SDF )
+    {
+        *shader = palette_type ? text_sdf_pal_shader : text_sdf_shader;
+        return palette_type ? &text_sdf_pal_uniforms : &text_sdf_uniforms;
+    }
+    *shader = palette_type ? text_pal_shader : text_shader;
+    return palette_type ? &text_pal_uniforms : &text_uniforms;
+};
+
+static unsigned int GetTextureChannels( int indexed )
+{
+    // Indexed textures only keep palette index, so they only need 1 channel from file.
+    return GetGLRGBA( indexed ) == GL_R8 ? 1 : 4;
+};
+
+static const TextureFileHeader * GetTextureFileHeader( const void * data, size_t size )
+{
+    if ( size < sizeof( TextureFileHeader ) )
+    {
+        return 0;
+    }
+    const TextureFileHeader * header = ( const TextureFileHeader * )( data );
+    if
+    (
+        memcmp( header->magic, TEXTURE_FILE_MAGIC, 4 ) != 0
+        || header->version != TEXTURE_FILE_VERSION
+        || header->format > TEXTURE_FILE_FORMAT_RGBA8
+        || header->width == 0
+        || header->height == 0
+        || header->levels == 0
+        || header->levels > TEXTURE_FILE_MAX_LEVELS
+        || ( max_texture_size > 0 && ( header->width > ( uint32_t )( max_texture_size ) || header->height > ( uint32_t )( max_texture_size ) ) )
+    )
+    {
+        return 0;
+    }
+
+    // Mip chain can’t go past 1x1.
+    unsigned int max_levels = 1;
+    for ( uint32_t extent = NASR_MATH_MAX( header->width, header->height ); extent > 1; extent >>= 1 )
+    {
+        ++max_levels;
+    }
+    if ( header->levels > max_levels )
+    {
+        return 0;
+    }
+
+    // Make sure file really holds every level it says it does.
+    size_t total = sizeof( TextureFileHeader );
+    for ( unsigned int level = 0; level < header->levels; ++level )
+    {
+        total += GetTextureFileLevelSize( header, level );
+    }
+    return total <= size ? header : 0;
+};
+
+static size_t GetTextureFileLevelSize( const TextureFileHeader * header, unsigned int level )
+{
+    const size_t w = NASR_MATH_MAX( header->width >> level, 1 );
+    const size_t h = NASR_MATH_MAX( header->height >> level, 1 );
+    return w * h * ( header->format == TEXTURE_FILE_FORMAT_R8 ? 1 : 4 );
+};
+
+static unsigned int GetTextureStorage( unsigned int texture )
+{
+    return textures[ texture ].atlas ? textures[ texture ].atlas_page : texture;
+};
+
+static unsigned char * GetTilemapChunk( NasrGraphicChunkedTilemap * tilemap, unsigned int chunk )
+{
+    // Chunks are allocated 1st time something is put in them, starting out as all empty tiles.
+    if ( !tilemap->chunks[ chunk ] )
+    {
+        unsigned char * data = calloc( TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE * 4, sizeof( unsigned char ) );
+        if ( !data )
+        {
+            return 0;
+        }
+        for ( unsigned int i = 0; i < TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE; ++i )
+        {
+            data[ i * 4 + 3 ] = 255;
+        }
+        tilemap->chunks[ chunk ] = data;
+    }
+    return tilemap->chunks[ chunk ];
+};
+
+static int GetTilemapProgram( unsigned int tilew, unsigned int tileh )
+{
+    // Reuse program already built for this tile size.
+    for ( unsigned int i = 0; i < tilemap_program_count; ++i )
+    {
+        if ( tilemap_programs[ i ].tilew == tilew && tilemap_programs[ i ].tileh == tileh )
+        {
+            return ( int )( i );
+        }
+    }
+
+    if ( tilemap_program_count >= MAX_TILEMAP_PROGRAMS )
+    {
+        NasrLog( "GetTilemapProgram Error: too many tile sizes; can’t build program for %ux%u tiles.", tilew, tileh );
+        return -1;
+    }
+
+    // Bake tile size into shader source as constant so shader math needs no uniform.
+    const char * bodies[ 3 ] = { tilemap_fragment_code, tilemap_mono_fragment_code, tilemap_layered_fragment_code };
+    unsigned int programs[ 3 ];
+    for ( int i = 0; i < 3; ++i )
+    {
+        const size_t len = strlen( bodies[ i ] ) + 128;
+        char * code = ( char * )( malloc( len ) );
+        if ( code == NULL )
+        {
+            NasrLog( "GetTilemapProgram Error: couldn’t allocate shader source." );
+            return -1;
+        }
+        snprintf( code, len, "#version 330 core\n#define TILE_SIZE vec2( %u.0, %u.0 )\n#define MAX_LAYERS %d\n%s", tilew, tileh, NASR_MAX_TILEMAP_LAYERS, bodies[ i ] );
+        NasrShader shaders[] =
+        {
+            { NASR_SHADER_VERTEX, vertex_shader_code },
+            { NASR_SHADER_FRAGMENT, code }
+        };
+        programs[ i ] = GenerateShaderProgram( shaders, 2 );
+        free( code );
+    }
+
+    TilemapProgram * p = &tilemap_programs[ tilemap_program_count ];
+    p->tilew = tilew;
+    p->tileh = tileh;
+    p->shader = programs[ 0 ];
+    p->mono_shader = programs[ 1 ];
+    p->layered_shader = programs[ 2 ];
+    p->uniforms.model          = glGetUniformLocation( p->shader, "model" );
+    p->uniforms.map_size       = glGetUniformLocation( p->shader, "map_size" );
+    p->uniforms.frames         = glGetUniformLocation( p->shader, "frame_data" );
+    p->uniforms.animtable      = glGetUniformLocation( p->shader, "animation_table" );
+    p->uniforms.opacity        = glGetUniformLocation( p->shader, "opacity" );
+    p->uniforms.texture        = glGetUniformLocation( p->shader, "texture_data" );
+    p->uniforms.palette        = glGetUniformLocation( p->shader, "palette_data" );
+    p->uniforms.mapdata        = glGetUniformLocation( p->shader, "map_data" );
+    p->uniforms.globalpal      = -1;
+    p->uniforms.tiling         = glGetUniformLocation( p->shader, "tiling" );
+    p->mono_uniforms.model     = glGetUniformLocation( p->mono_shader, "model" );
+    p->mono_uniforms.map_size  = glGetUniformLocation( p->mono_shader, "map_size" );
+    p->mono_uniforms.frames    = glGetUniformLocation( p->mono_shader, "frame_data" );
+    p->mono_uniforms.animtable = glGetUniformLocation( p->mono_shader, "animation_table" );
+    p->mono_uniforms.opacity   = glGetUniformLocation( p->mono_shader, "opacity" );
+    p->mono_uniforms.texture   = glGetUniformLocation( p->mono_shader, "texture_data" );
+    p->mono_uniforms.palette   = glGetUniformLocation( p->mono_shader, "palette_data" );
+    p->mono_uniforms.mapdata   = glGetUniformLocation( p->mono_shader, "map_data" );
+    p->mono_uniforms.globalpal = glGetUniformLocation( p->mono_shader, "global_palette" );
+    p->mono_uniforms.tiling    = glGetUniformLocation( p->mono_shader, "tiling" );
+    p->layered_uniforms.model         = glGetUniformLocation( p->layered_shader, "model" );
+    p->layered_uniforms.map_size      = glGetUniformLocation( p->layered_shader, "map_size" );
+    p->layered_uniforms.view_size     = glGetUniformLocation( p->layered_shader, "view_size" );
+    p->layered_uniforms.frames        = glGetUniformLocation( p->layered_shader, "frame_data" );
+    p->layered_uniforms.animtable     = glGetUniformLocation( p->layered_shader, "animation_table" );
+    p->layered_uniforms.texture       = glGetUniformLocation( p->layered_shader, "texture_data" );
+    p->layered_uniforms.palette       = glGetUniformLocation( p->layered_shader, "palette_data" );
+    p->layered_uniforms.mapdata       = glGetUniformLocation( p->layered_shader, "map_data" );
+    p->layered_uniforms.layer_count   = glGetUniformLocation( p->layered_shader, "layer_count" );
+    p->layered_uniforms.layer_offset  = glGetUniformLocation( p->layered_shader, "layer_offset" );
+    p->layered_uniforms.layer_opacity = glGetUniformLocation( p->layered_shader, "layer_opacity" );
+    p->layered_uniforms.useglobalpal  = glGetUniformLocation( p->layered_shader, "use_global_palette" );
+    p->layered_uniforms.globalpal     = glGetUniformLocation( p->layered_shader, "global_palette" );
+    ++tilemap_program_count;
+
+    // If view has already been set, give new programs same ortho as all other shaders.
+    if ( ortho_view.w > 0.0f && ortho_view.h > 0.0f )
+    {
+        UpdateShaderOrtho( ortho_view.x, ortho_view.y, ortho_view.w, ortho_view.h );
+    }
+
+    return ( int )( tilemap_program_count - 1 );
+};
+
+static float * GetVertices( unsigned int id )
+{
+    return &vertices[ id * VERTEX_RECT_SIZE ];
+};
+
+static int GraphicsAddCounter
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    unsigned int charset,
+    float num,
+    unsigned int maxdigits,
+    unsigned int maxdecimals,
+    float x,
+    float y,
+    float shadow,
+    float opacity,
+    uint_fast8_t numpadding,
+    uint_fast8_t decimalpadding,
+    NasrColor ** colors,
+    uint_fast8_t palette,
+    uint_fast8_t palette_type
+)
+{
+    if ( charset >= charmaps.capacity || !charmaps.list[ charset ].list )
+    {
+        return -1;
+    }
+
+    struct NasrGraphic graphic;
+    graphic.scrollx = scrollx;
+    graphic.scrolly = scrolly;
+    graphic.type = NASR_GRAPHIC_COUNTER;
+    graphic.data.counter = calloc( 1, sizeof( NasrGraphicCounter ) );
+    graphic.data.counter->palette = palette;
+    graphic.data.counter->palette_type = palette_type;
+    graphic.data.counter->numpadding = numpadding;
+    graphic.data.counter->decimalpadding = decimalpadding;
+    graphic.data.counter->maxdigits = maxdigits;
+    graphic.data.counter->maxdecimals = maxdecimals;
+    // If no decimals, just have max chars maxdecimals, else have 1 extra for floating point char.
+    int count = maxdigits + ( maxdecimals > 0 ? maxdecimals + 1 : 0 );
+    if ( count > MAX_COUNTER_DIGITS )
+    {
+        NasrLog( "NasrGraphicsAddCounter Error: counter can’t have mo’ than %d characters.", MAX_COUNTER_DIGITS );
+        free( graphic.data.counter );
+        return -1;
+    }
+    graphic.data.counter->count = count;
+    graphic.data.counter->maxnum = pow( 10, maxdigits ) - pow( 10, ( int )( -maxdecimals - 1 ) );
+    graphic.data.counter->charset = charset;
+    graphic.data.counter->xoffset = x;
+    graphic.data.counter->yoffset = y;
+    graphic.data.counter->shadow = shadow;
+    graphic.data.counter->opacity = opacity;
+    if ( colors )
+    {
+        for ( int j = 0; j < 4; ++j )
+        {
+            memcpy( &graphic.data.counter->colors[ j ], colors[ j ], sizeof( NasrColor ) );
+        }
+    }
+    SetCounterDigits( graphic.data.counter, num );
+    const int id = AddGraphic( state, layer, graphic );
+    if ( id < 0 )
+    {
+        free( graphic.data.counter );
+        return -1;
+    }
+
+    // All digits share 1 quad; shader picks each digit’s src & position from digits list.
+    NasrGraphicCounter * counter = graphic.data.counter;
+    glGenVertexArrays( 1, &counter->vao );
+    glGenBuffers( 1, &counter->vbo );
+    glBindVertexArray( counter->vao );
+    glBindBuffer( GL_ARRAY_BUFFER, counter->vbo );
+    ResetVertices( counter->vertices );
+    SetVerticesColorValues( counter->vertices, &counter->colors[ 0 ], &counter->colors[ 1 ], &counter->colors[ 2 ], &counter->colors[ 3 ] );
+    BufferDefault( counter->vertices );
+    ClearBufferBindings();
+
+    return id;
+};
+
+static int GraphicAddText
+(
+    float scrollx,
+	float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    NasrColor * top_left_color,
+    NasrColor * top_right_color,
+    NasrColor * bottom_left_color,
+    NasrColor * bottom_right_color,
+    uint_fast8_t palette,
+    uint_fast8_t palette_type
+)
+{
+    if ( text.charset >= charmaps.capacity || !charmaps.list[ text.charset ].list )
+    {
+        return -1;
+    }
+
+    // Generate char list from string.
+    float charw = text.coords.w - text.padding_left - text.padding_right;
+    float charh = text.coords.h - text.padding_top - text.padding_bottom;
+    float charx = text.coords.x + text.padding_left;
+    float chary = text.coords.y + text.padding_top;
+    const float lnend = charx + charw;
+
+    char * string = text.string;
+    CharTemplate letters[ strlen( string ) ];
+    int lettercount = 0;
+    while ( *string )
+    {
+        const int charlen = GetCharacterSize( string );
+
+        // Generate letter string
+        char letter[ charlen + 1 ];
+        strncpy( letter, string, charlen );
+        letter[ charlen ] = 0;
+
+        // Find character
+        hash_t needle_hash = CharMapHashString( text.charset, letter );
+        CharMapEntry * entry = CharMapHashFindEntry( text.charset, letter, needle_hash );
+        if ( entry->key.string == NULL )
+        {
+            needle_hash = CharMapHashString( text.charset, "default" );
+            entry = CharMapHashFindEntry( text.charset, "default", needle_hash );
+            if ( entry->key.string )
+            {
+                letters[ lettercount ] = entry->value;
+            }
+        }
+        else
+        {
+            letters[ lettercount ] = entry->value;
+        }
+
+        ++lettercount;
+        string += charlen;
+    }
+    int maxlines = ( int )( charh );
+    int maxperline = ( int )( charw );
+    CharTemplate lines[ maxlines ][ maxperline ];
+    float line_widths[ maxlines ];
+    line_widths[ 0 ] = 0;
+    int line_character_counts[ maxlines ];
+    int line_count = 0;
+    int line_character = 0;
+    long unsigned int i = 0;
+    int lx = ( int )( charx );
+    int endswithnewline[ maxlines ];
+    while ( i < lettercount )
+    {
+        long unsigned int ib = i;
+        float xb = lx;
+        int look_ahead = 1;
+
+        // Look ahead so we can know ahead o’ time whether we need to add a new line.
+        // This autobreaks text without cutting midword.
+        while ( look_ahead )
+        {
+            if ( ib >= lettercount )
+            {
+                look_ahead = 0;
+                break;
+            }
+
+            if ( letters[ ib ].chartype == NASR_CHAR_NEWLINE )
+            {
+                look_ahead = 0;
+            }
+            else if ( letters[ ib ].chartype == NASR_CHAR_WHITESPACE )
+            {
+                look_ahead = 0;
+            }
+            else if ( xb >= lnend )
+            {
+                lx = ( int )( charx );
+                line_character_counts[ line_count ] = line_character;
+                endswithnewline[ line_count ] = 0;
+                ++line_count;
+                line_widths[ line_count ] = 0;
+                line_character = 0;
+                look_ahead = 0;
+            }
+            else if ( ib >= lettercount )
+            {
+                look_ahead = 0;
+                break;
+            }
+            xb += letters[ ib ].src.w;
+            ++ib;
+        }
+
+        while ( i < ib )
+        {
+            if ( letters[ i ].chartype == NASR_CHAR_NEWLINE || lx >= lnend )
+            {
+                lx = ( int )( charx );
+                line_character_counts[ line_count ] = line_character;
+                endswithnewline[ line_count ] = letters[ i ].chartype == NASR_CHAR_NEWLINE;
+                ++line_count;
+                line_widths[ line_count ] = 0;
+                line_character = 0;
+            }
+            else
+            {
+                lines[ line_count ][ line_character ] = letters[ i ];
+                line_widths[ line_count ] += letters[ i ].src.w;
+                ++line_character;
+                lx += letters[ i ].src.w;
+            }
+            ++i;
+        }
+    }
+    line_character_counts[ line_count ] = line_character;
+    ++line_count;
+
+    int finalcharcount = 0;
+    float maxh[ line_count ];
+
+    for ( int l = 0; l < line_count; ++l )
+    {
+        finalcharcount += line_character_counts[ l ];
+
+        maxh[ l ] = 8.0f;
+        for ( int c = 0; c < line_character_counts[ l ]; ++c )
+        {
+            if ( lines[ l ][ c ].src.h > maxh[ l ] )
+            {
+                maxh[ l ] = lines[ l ][ c ].src.h;
+            }
+        }
+
+        // Sometimes the previous loop keeps whitespace @ the end o’ lines.
+        // Since this messes with x alignment, remove these.
+        if ( lines[ l ][ line_character_counts[ l ] - 1 ].chartype == NASR_CHAR_WHITESPACE )
+        {
+            --line_character_counts[ l ];
+            line_widths[ l ] -= lines[ l ][ line_character_counts[ l ] - 1 ].src.w;
+        }
+    }
+
+    NasrChar chars[ finalcharcount ];
+    int count = 0;
+    // Final loop: we have all the info we need now to set x & y positions.
+    float dy = ( text.valign == NASR_VALIGN_MIDDLE )
+        ? chary + ( ( charh - ( line_count * 8.0 ) ) / 2.0 )
+        : ( text.valign == NASR_VALIGN_BOTTOM )
+            ? chary + charh - ( line_count * 8.0 )
+            : chary;
+    for ( int l = 0; l < line_count; ++l )
+    {
+        float dx = ( text.align == NASR_ALIGN_CENTER )
+            ? charx + ( ( charw - line_widths[ l ] ) / 2.0 )
+            : ( text.align == NASR_ALIGN_RIGHT )
+                ? lnend - line_widths[ l ]
+                : charx;
+
+        // Add justified spacing if set to justified & not an endline.
+        float letterspace = text.align == NASR_ALIGN_JUSTIFIED && line_character_counts[ l ] > 0 && l < line_count - 1 && !endswithnewline[ l ]
+            ? ( charw - line_widths[ l ] ) / ( float )( line_character_counts[ l ] - 1 )
+            : 0.0f;
+
+        for ( int c = 0; c < line_character_counts[ l ]; ++c )
+        {
+            // Just in case o’ character index misalignment, just copy o’er whole characters.
+            if ( lines[ l ][ c ].chartype != NASR_CHAR_WHITESPACE ) {
+                chars[ count ].src = lines[ l ][ c ].src;
+                chars[ count ].dest = lines[ l ][ c ].src;
+                chars[ count ].dest.x = dx;
+                chars[ count ].dest.y = dy + ( ( maxh[ l ] - lines[ l ][ c ].src.h ) / 2.0 );
+                ++count;
+            }
+            if ( lines[ l ][ c ].src.w > 0.0f ) {
+                dx += ( lines[ l ][ c ].src.w + letterspace );
+            }
+        }
+        dy += maxh[ l ];
+    }
+
+    // End charlist
+
+    struct NasrGraphic graphic;
+    graphic.scrollx = scrollx;
+    graphic.scrolly = scrolly;
+    graphic.type = NASR_GRAPHIC_TEXT;
+    graphic.data.text.charset = text.charset;
+    graphic.data.text.palette = palette;
+    graphic.data.text.palette_type = palette_type;
+    graphic.data.text.capacity = graphic.data.text.count = count;
+    graphic.data.text.xoffset = text.xoffset;
+    graphic.data.text.yoffset = text.yoffset;
+    graphic.data.text.shadow = text.shadow;
+    graphic.data.text.opacity = text.opacity;
+    graphic.data.text.scale = 1.0f;
+    graphic.data.text.originx = text.coords.x;
+    graphic.data.text.originy = text.coords.y;
+    graphic.data.text.vaos = calloc( count, sizeof( unsigned int ) );
+    graphic.data.text.vbos = calloc( count, sizeof( unsigned int ) );
+    graphic.data.text.vertices = calloc( count * VERTEX_RECT_SIZE, sizeof( float ) );
+    graphic.data.text.chars = calloc( count, sizeof( NasrChar ) );
+    memcpy( graphic.data.text.chars, chars, count * sizeof( NasrChar ) );
+    const int id = AddGraphic( state, layer, graphic );
+
+    NasrGraphic * g = GetGraphic( id );
+    glGenVertexArrays( count, g->data.text.vaos );
+    glGenBuffers( count, g->data.text.vbos );
+
+    for ( int i = 0; i < count; ++i )
+    {
+        float * vptr = &g->data.text.vertices[ i * VERTEX_RECT_SIZE ];
+        #define CHARACTER g->data.text.chars[ i ]
+
+        glBindVertexArray( g->data.text.vaos[ i ] );
+        glBindBuffer( GL_ARRAY_BUFFER, g->data.text.vbos[ i ] );
+
+        ResetVertices( vptr );
+        UpdateCharVertices( vptr, &CHARACTER.src, &charmaps.list[ text.charset ].texture );
+
+        if ( bottom_right_color )
+        {
+            vptr[ 4 ] = bottom_right_color->r / 255.0f;
+            vptr[ 5 ] = bottom_right_color->g / 255.0f;
+            vptr[ 6 ] = bottom_right_color->b / 255.0f;
+            vptr[ 7 ] = bottom_right_color->a / 255.0f;
+
+            vptr[ 4 + VERTEX_SIZE ] = top_right_color->r / 255.0f;
+            vptr[ 5 + VERTEX_SIZE ] = top_right_color->g / 255.0f;
+            vptr[ 6 + VERTEX_SIZE ] = top_right_color->b / 255.0f;
+            vptr[ 7 + VERTEX_SIZE ] = top_right_color->a / 255.0f;
+
+            vptr[ 4 + VERTEX_SIZE * 2 ] = top_left_color->r / 255.0f;
+            vptr[ 5 + VERTEX_SIZE * 2 ] = top_left_color->g / 255.0f;
+            vptr[ 6 + VERTEX_SIZE * 2 ] = top_left_color->b / 255.0f;
+            vptr[ 7 + VERTEX_SIZE * 2 ] = top_left_color->a / 255.0f;
+
+            vptr[ 4 + VERTEX_SIZE * 3 ] = bottom_left_color->r / 255.0f;
+            vptr[ 5 + VERTEX_SIZE * 3 ] = bottom_left_color->g / 255.0f;
+            vptr[ 6 + VERTEX_SIZE * 3 ] = bottom_left_color->b / 255.0f;
+            vptr[ 7 + VERTEX_SIZE * 3 ] = bottom_left_color->a / 255.0f;
+        }
+       
+        #undef CHARACTER
+
+        BufferDefault( vptr );
+    }
+    ClearBufferBindings();
+
+    return id;
+};
+
+static int GraphicAddTextStream
+(
+    float scrollx,
+    float scrolly,
+    unsigned int state,
+    unsigned int layer,
+    NasrText text,
+    NasrColor color,
+    uint_fast8_t palette,
+    uint_fast8_t palette_type
+)
+{
+    if ( text.charset >= charmaps.capacity || !charmaps.list[ text.charset ].list )
+    {
+        return -1;
+    }
+
+    struct NasrGraphic graphic;
+    graphic.scrollx = scrollx;
+    graphic.scrolly = scrolly;
+    graphic.type = NASR_GRAPHIC_TEXT_STREAM;
+    graphic.data.stream = calloc( 1, sizeof( NasrGraphicTextStream ) );
+    if ( !graphic.data.stream )
+    {
+        NasrLog( "NasrGraphicsAddTextStream Error: ¡Not ’nough memory for text stream!" );
+        return -1;
+    }
+
+    #define STREAM graphic.data.stream
+
+    // Only line breaks are worked out now; glyphs are laid out a line @ a time as they scroll into view.
+    STREAM->charset = text.charset;
+    STREAM->string = strdup( text.string );
+    if ( !STREAM->string || LayoutTextStream( STREAM, &text ) )
+    {
+        NasrLog( "NasrGraphicsAddTextStream Error: ¡Not ’nough memory for text stream!" );
+        free( STREAM->string );
+        free( STREAM );
+        return -1;
+    }
+    STREAM->count = STREAM->glyph_count;
+    STREAM->budget = TEXT_STREAM_DEFAULT_BUDGET;
+    STREAM->palette = palette;
+    STREAM->palette_type = palette_type;
+    STREAM->coords = text.coords;
+    STREAM->color = color;
+    STREAM->xoffset = text.xoffset;
+    STREAM->yoffset = text.yoffset;
+    STREAM->shadow = text.shadow;
+    STREAM->opacity = text.opacity;
+
+    // Lines are @ least 8 pixels tall, so this many slots always covers box plus partial lines on either end.
+    STREAM->window_lines = ( unsigned int )( NASR_MATH_MAX( text.coords.h, 0.0f ) / 8.0f ) + 3;
+    STREAM->max_line_glyphs = NASR_MATH_MAX( STREAM->max_line_glyphs, 1 );
+    STREAM->slot_lines = malloc( STREAM->window_lines * sizeof( int ) );
+    STREAM->vertices = malloc( STREAM->max_line_glyphs * VERTEX_RECT_SIZE * sizeof( float ) );
+    unsigned int * indices = malloc( STREAM->max_line_glyphs * 6 * sizeof( unsigned int ) );
+    if ( !STREAM->slot_lines || !STREAM->vertices || !indices )
+    {
+        NasrLog( "NasrGraphicsAddTextStream Error: ¡Not ’nough memory for text stream!" );
+        free( indices );
+        free( STREAM->slot_lines );
+        free( STREAM->vertices );
+        free( STREAM->lines );
+        free( STREAM->string );
+        free( STREAM );
+        return -1;
+    }
+    for ( unsigned int i = 0; i < STREAM->window_lines; ++i )
+    {
+        STREAM->slot_lines[ i ] = -1;
+    }
+    for ( unsigned int i = 0; i < STREAM->max_line_glyphs; ++i )
+    {
+        indices[ i * 6 ] = i * 4;
+        indices[ i * 6 + 1 ] = i * 4 + 1;
+        indices[ i * 6 + 2 ] = i * 4 + 3;
+        indices[ i * 6 + 3 ] = i * 4 + 1;
+        indices[ i * 6 + 4 ] = i * 4 + 2;
+        indices[ i * 6 + 5 ] = i * 4 + 3;
+    }
+
+    // 1 buffer holds every slot; each slot has room for longest line.
+    glGenVertexArrays( 1, &STREAM->vao );
+    glGenBuffers( 1, &STREAM->vbo );
+    glGenBuffers( 1, &STREAM->ebo );
+    glBindVertexArray( STREAM->vao );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, STREAM->ebo );
+    glBufferData( GL_ELEMENT_ARRAY_BUFFER, STREAM->max_line_glyphs * 6 * sizeof( unsigned int ), indices, GL_STATIC_DRAW );
+    glBindBuffer( GL_ARRAY_BUFFER, STREAM->vbo );
+    glBufferData( GL_ARRAY_BUFFER, STREAM->window_lines * STREAM->max_line_glyphs * VERTEX_RECT_SIZE * sizeof( float ), 0, GL_DYNAMIC_DRAW );
+    glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), 0 );
+    glEnableVertexAttribArray( 0 );
+    glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), ( void * )( 2 * sizeof( float ) ) );
+    glEnableVertexAttribArray( 1 );
+    glVertexAttribPointer( 2, 4, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof( float ), ( void * )( 4 * sizeof( float ) ) );
+    glEnableVertexAttribArray( 2 );
+    ClearBufferBindings();
+    free( indices );
+
+    #undef STREAM
+
+    const int id = AddGraphic( state, layer, graphic );
+    if ( id < 0 )
+    {
+        DestroyGraphic( &graphic );
+        return -1;
+    }
+    return id;
+};
+
+static void GraphicsRectGradientPaletteUpdateColors( unsigned int id, uint_fast8_t * c )
+{
+    NasrColor cobj[ 4 ];
+    for ( int i = 0; i < 4; ++i )
+    {
+        cobj[ i ].r = ( float )( c[ i ] );
+        cobj[ i ].a = 255.0f;
+    }
+    ResetVertices( GetVertices( id ) );
+    SetVerticesColors( id, &cobj[ 0 ], &cobj[ 1 ], &cobj[ 2 ], &cobj[ 3 ] );
+};
+
+static void GraphicsUpdateRectPalette( unsigned int id, uint_fast8_t color )
+{
+    NasrColor c =
+    {
+        ( float )( color ),
+        0.0f,
+        0.0f,
+        255.0f
+    };
+    ResetVertices( GetVertices( id ) );
+    SetVerticesColors( id, &c, &c, &c, &c );
+};
+
+static int GrowGraphics( void )
+{
+    const unsigned int new_max_graphics = max_graphics * 2;
+    const unsigned int size_diff = new_max_graphics - max_graphics;
+
+    unsigned int * new_vaos = calloc( ( new_max_graphics + 1 ), sizeof( unsigned int ) );
+    unsigned int * new_vbos = calloc( ( new_max_graphics + 1 ), sizeof( unsigned int ) );
+    float * new_vertices = calloc( ( new_max_graphics + 1 ) * VERTEX_RECT_SIZE, sizeof( float ) );
+    NasrGraphic * new_graphics = calloc( new_max_graphics, sizeof( NasrGraphic ) );
+    int * new_gfx_ptrs_id_to_pos = calloc( new_max_graphics, sizeof( int ) );
+    int * new_gfx_ptrs_pos_to_id = calloc( new_max_graphics, sizeof( int ) );
+    int * new_state_for_gfx = calloc( new_max_graphics, sizeof( int ) );
+    int * new_layer_for_gfx = calloc( new_max_graphics, sizeof( int ) );
+    if
+    (
+        !new_vaos ||
+        !new_vbos ||
+        !new_vertices ||
+        !new_graphics ||
+        !new_gfx_ptrs_id_to_pos ||
+        !new_gfx_ptrs_pos_to_id ||
+        !new_state_for_gfx ||
+        !new_layer_for_gfx
+    )
+    {
+        NasrLog( "AddGraphic Error: ¡Not ’nough memory for graphics!" );
+        return 0;
+    }
+
+    memcpy( new_vaos, vaos, ( max_graphics + 1 ) * sizeof( unsigned int ) );
+    memcpy( new_vbos, vbos, ( max_graphics + 1 ) * sizeof( unsigned int ) );
+    memcpy( new_vertices, vertices, ( max_graphics + 1 ) * VERTEX_RECT_SIZE * sizeof( float ) );
+    memcpy( new_graphics, graphics, max_graphics * sizeof( NasrGraphic ) );
+    memcpy( new_gfx_ptrs_id_to_pos, gfx_ptrs_id_to_pos, max_graphics * sizeof( int ) );
+    memcpy( new_gfx_ptrs_pos_to_id, gfx_ptrs_pos_to_id, max_graphics * sizeof( int ) );
+    memcpy( new_state_for_gfx, state_for_gfx, max_graphics * sizeof( int ) );
+    memcpy( new_layer_for_gfx, layer_for_gfx, max_graphics * sizeof( int ) );
+
+    free( vaos );
+    free( vbos );
+    free( vertices );
+    free( graphics );
+    free( gfx_ptrs_id_to_pos );
+    free( gfx_ptrs_pos_to_id );
+    free( state_for_gfx );
+    free( layer_for_gfx );
+
+    vaos = new_vaos;
+    vbos = new_vbos;
+    vertices = new_vertices;
+    graphics = new_graphics;
+    gfx_ptrs_id_to_pos = new_gfx_ptrs_id_to_pos;
+    gfx_ptrs_pos_to_id = new_gfx_ptrs_pos_to_id;
+    state_for_gfx = new_state_for_gfx;
+    layer_for_gfx = new_layer_for_gfx;
+
+    glGenVertexArrays( size_diff, &vaos[ max_graphics + 1 ] );
+    glGenBuffers( size_diff, &vbos[ max_graphics + 1 ] );
+    for ( int i = max_graphics + 1; i < new_max_graphics + 1; ++i )
+    {
+        float * vptr = GetVertices( i );
+        ResetVertices( vptr );
+        BindBuffers( i );
+        BufferDefault( vptr );
+    }
+    ClearBufferBindings();
+
+    // Initialize these to null values ( since 0 is a valid value, we use -1 ).
+    for ( int i = max_graphics; i < new_max_graphics; ++i )
+    {
+        gfx_ptrs_id_to_pos[ i ] = gfx_ptrs_pos_to_id[ i ] = state_for_gfx[ i ] = layer_for_gfx[ i ] = -1;
+    }
+
+    max_graphics = new_max_graphics;
+    return 1;
+};
+
+static int GrowTextureArray( TextureArray * array )
+{
+    GLint max_layers;
+    glGetIntegerv( GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers );
+    const unsigned int capacity = NASR_MATH_MIN( array->capacity * 2, ( unsigned int )( max_layers ) );
+    if ( capacity <= array->capacity )
+    {
+        return -1;
+    }
+    const GLuint id = CreateTextureArray( array->width, array->height, capacity, array->sampling, array->indexed );
+    if ( !id )
+    {
+        return -1;
+    }
+
+    // Move existing layers o’er on GPU 1 @ a time.
+    GLint prev_read_framebuffer;
+    GLint prev_draw_framebuffer;
+    glGetIntegerv( GL_READ_FRAMEBUFFER_BINDING, &prev_read_framebuffer );
+    glGetIntegerv( GL_DRAW_FRAMEBUFFER_BINDING, &prev_draw_framebuffer );
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, copy_framebuffers[ 0 ] );
+    glBindFramebuffer( GL_DRAW_FRAMEBUFFER, copy_framebuffers[ 1 ] );
+    for ( unsigned int layer = 0; layer < array->count; ++layer )
+    {
+        glFramebufferTextureLayer( GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, array->id, 0, layer );
+        glFramebufferTextureLayer( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, id, 0, layer );
+        glBlitFramebuffer( 0, 0, array->width, array->height, 0, 0, array->width, array->height, GL_COLOR_BUFFER_BIT, GL_NEAREST );
+    }
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, prev_read_framebuffer );
+    glBindFramebuffer( GL_DRAW_FRAMEBUFFER, prev_draw_framebuffer );
+
+    // Only base level got copied, so smaller levels need rebuilt.
+    if ( TextureMipmapped( array->sampling, array->indexed ) )
+    {
+        glBindTexture( GL_TEXTURE_2D_ARRAY, id );
+        glGenerateMipmap( GL_TEXTURE_2D_ARRAY );
+        ResetTextureBindings();
+    }
+
+    glDeleteTextures( 1, &array->id );
+    texture_bytes -= ( uint64_t )( array->width ) * array->height * array->capacity * ( array->indexed == GL_R8 ? 1 : 4 );
+    array->id = id;
+    array->capacity = capacity;
+    return 0;
+};
+
+static int IsTextureFile( const char * filename )
+{
+    // Just peek @ header so ordinary image files don’t get mapped only to be handed to stb_image.
+    FILE * file = fopen( filename, "rb" );
+    if ( !file )
+    {
+        return 0;
+    }
+    TextureFileHeader header;
+    const size_t read = fread( &header, 1, sizeof( TextureFileHeader ), file );
+    fclose( file );
+    return read == sizeof( TextureFileHeader )
+        && memcmp( header.magic, TEXTURE_FILE_MAGIC, 4 ) == 0
+        && header.version == TEXTURE_FILE_VERSION;
+};
+
+static int LayoutTextStream( NasrGraphicTextStream * stream, const NasrText * text )
+{
+    const float charw = text->coords.w - text->padding_left - text->padding_right;
+    const float charx = text->coords.x + text->padding_left;
+    const unsigned int length = strlen( stream->string );
+    unsigned int capacity = 64;
+    stream->lines = malloc( capacity * sizeof( TextStreamLine ) );
+    if ( !stream->lines )
+    {
+        return -1;
+    }
+
+    float y = text->coords.y + text->padding_top;
+    unsigned int i = 0;
+    while ( i < length )
+    {
+        // Find where line ends, breaking on last whitespace that fits, or mid-word if word is longer than line.
+        const unsigned int start = i;
+        unsigned int end = length;
+        unsigned int next = length;
+        unsigned int break_end = 0;
+        unsigned int break_next = 0;
+        uint_fast8_t has_break = 0;
+        uint_fast8_t has_glyph = 0;
+        uint_fast8_t newline = 0;
+        float w = 0.0f;
+        while ( i < length )
+        {
+            int len;
+            const CharTemplate * c = FindCharTemplate( stream->charset, &stream->string[ i ], &len );
+            if ( !c )
+            {
+                i += len;
+                continue;
+            }
+
+            if ( c->chartype == NASR_CHAR_NEWLINE )
+            {
+                end = i;
+                next = i + len;
+                newline = 1;
+                break;
+            }
+            else if ( c->chartype == NASR_CHAR_WHITESPACE )
+            {
+                if ( has_glyph )
+                {
+                    has_break = 1;
+                    break_end = i;
+                    break_next = i + len;
+                }
+            }
+            else if ( has_glyph && w + c->src.w > charw )
+            {
+                end = has_break ? break_end : i;
+                next = has_break ? break_next : i;
+                break;
+            }
+            else
+            {
+                has_glyph = 1;
+            }
+            w += c->src.w;
+            i += len;
+        }
+
+        // Measure line, leaving out trailing whitespace from width.
+        TextStreamLine line = { start, end, 0, stream->glyph_count, charx, y, 8.0f, 0.0f };
+        unsigned int chars = 0;
+        float x = 0.0f;
+        float width = 0.0f;
+        for ( unsigned int j = start; j < end; )
+        {
+            int len;
+            const CharTemplate * c = FindCharTemplate( stream->charset, &stream->string[ j ], &len );
+            j += len;
+            if ( !c )
+            {
+                continue;
+            }
+            ++chars;
+            x += c->src.w;
+            if ( c->chartype != NASR_CHAR_WHITESPACE )
+            {
+                ++line.glyphs;
+                width = x;
+                line.height = NASR_MATH_MAX( line.height, c->src.h );
+            }
+        }
+
+        line.x = ( text->align == NASR_ALIGN_CENTER )
+            ? charx + ( ( charw - width ) / 2.0f )
+            : ( text->align == NASR_ALIGN_RIGHT )
+                ? charx + charw - width
+                : charx;
+
+        // Add justified spacing if set to justified & not an endline.
+        line.letterspace = text->align == NASR_ALIGN_JUSTIFIED && chars > 1 && next < length && !newline
+            ? ( charw - width ) / ( float )( chars - 1 )
+            : 0.0f;
+
+        if ( stream->line_count == capacity )
+        {
+            capacity *= 2;
+            TextStreamLine * lines = realloc( stream->lines, capacity * sizeof( TextStreamLine ) );
+            if ( !lines )
+            {
+                free( stream->lines );
+                stream->lines = 0;
+                return -1;
+            }
+            stream->lines = lines;
+        }
+        stream->lines[ stream->line_count++ ] = line;
+        stream->glyph_count += line.glyphs;
+        stream->max_line_glyphs = NASR_MATH_MAX( stream->max_line_glyphs, line.glyphs );
+        y += line.height;
+        i = next;
+    }
+    return 0;
 };
 
-static unsigned int GetStateLayerIndex( unsigned int state, unsigned int layer )
+static unsigned char * LoadTextureFileData( const char * filename, unsigned int * width, unsigned int * height, int sampling, int indexed, int baked )
 {
-    return state * max_gfx_layers + layer;
+    const unsigned int channels = GetTextureChannels( indexed );
+
+    // Baked texture files just need their base level converted to channels asked for.
+    size_t size;
+    void * file = baked ? NasrMapFile( filename, &size ) : 0;
+    const TextureFileHeader * header = file ? GetTextureFileHeader( file, size ) : 0;
+    if ( header )
+    {
+        const size_t count = ( size_t )( header->width ) * header->height;
+        const unsigned int file_channels = header->format == TEXTURE_FILE_FORMAT_R8 ? 1 : 4;
+        const unsigned char * src = ( const unsigned char * )( header + 1 );
+        unsigned char * data = malloc( count * channels );
+        if ( data )
+        {
+            if ( file_channels == channels )
+            {
+                memcpy( data, src, count * channels );
+            }
+            else if ( channels == 1 )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    data[ i ] = src[ i * 4 ];
+                }
+            }
+            else
+            {
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    data[ i * 4 ] = src[ i ];
+                    data[ i * 4 + 1 ] = data[ i * 4 + 2 ] = 0;
+                    data[ i * 4 + 3 ] = 255;
+                }
+            }
+            *width = header->width;
+            *height = header->height;
+        }
+        NasrUnmapFile( file, size );
+        return data;
+    }
+    if ( file )
+    {
+        NasrUnmapFile( file, size );
+    }
+
+    // For indexed textures, take file’s own channels so nothing gets expanded to RGBA just to be thrown away.
+    int file_channels;
+    int w;
+    int h;
+    unsigned char * data = stbi_load( filename, &w, &h, &file_channels, channels == 1 ? 0 : STBI_rgb_alpha );
+    if ( data == NULL || w < 0 || h < 0 )
+    {
+        NasrLog( "Couldn’t load texture file “%s”.", filename );
+        return 0;
+    }
+
+    // Palette index is 1st channel; squeeze it down in place.
+    if ( channels == 1 && file_channels > 1 )
+    {
+        const size_t count = ( size_t )( w ) * h;
+        for ( size_t i = 0; i < count; ++i )
+        {
+            data[ i ] = data[ i * file_channels ];
+        }
+    }
+    *width = w;
+    *height = h;
+    return data;
 };
 
-static float * GetVertices( unsigned int id )
+static void MarkTilemapDirty( NasrGraphicTilemap * tilemap, int x, int y, int w, int h )
 {
-    return &vertices[ id * VERTEX_RECT_SIZE ];
+    // Every tile edit comes through here, so keep collision data & baked chunks in sync with it.
+    UpdateTilemapSolidity( tilemap, x, y, w, h );
+    if ( tilemap->bake )
+    {
+        tilemap->bake_check = 1;
+        if ( tilemap->bake_stale )
+        {
+            const int left = x * tilemap->tilew / TILEMAP_BAKE_SIZE;
+            const int right = ( ( x + w ) * tilemap->tilew - 1 ) / TILEMAP_BAKE_SIZE;
+            const int top = y * tilemap->tileh / TILEMAP_BAKE_SIZE;
+            const int bottom = ( ( y + h ) * tilemap->tileh - 1 ) / TILEMAP_BAKE_SIZE;
+            for ( int cy = top; cy <= bottom; ++cy )
+            {
+                for ( int cx = left; cx <= right; ++cx )
+                {
+                    tilemap->bake_stale[ cy * tilemap->bake_chunksw + cx ] = 1;
+                }
+            }
+        }
+    }
+
+    // Fold new rect into whichever dirty rect grows least from it; only start new rect if that would
+    // mean uploading extra tiles that weren’t changed.
+    int best = -1;
+    int64_t best_cost = 0;
+    NasrRectInt best_union;
+    for ( uint_fast8_t i = 0; i < tilemap->dirty_count; ++i )
+    {
+        const NasrRectInt * r = &tilemap->dirty[ i ];
+        NasrRectInt u;
+        u.x = NASR_MATH_MIN( r->x, x );
+        u.y = NASR_MATH_MIN( r->y, y );
+        u.w = NASR_MATH_MAX( r->x + r->w, x + w ) - u.x;
+        u.h = NASR_MATH_MAX( r->y + r->h, y + h ) - u.y;
+        const int64_t cost = ( int64_t )( u.w ) * u.h - ( int64_t )( r->w ) * r->h - ( int64_t )( w ) * h;
+        if ( best < 0 || cost < best_cost )
+        {
+            best = i;
+            best_cost = cost;
+            best_union = u;
+        }
+    }
+
+    if ( best >= 0 && ( best_cost <= 0 || tilemap->dirty_count == MAX_TILEMAP_DIRTY_RECTS ) )
+    {
+        tilemap->dirty[ best ] = best_union;
+    }
+    else
+    {
+        NasrRectInt r = { x, y, w, h };
+        tilemap->dirty[ tilemap->dirty_count++ ] = r;
+    }
 };
 
-static int GraphicsAddCounter
-(
-    float scrollx,
-	float scrolly,
-    unsigned int state,
-    unsigned int layer,
-    unsigned int charset,
-    float num,
-    unsigned int maxdigits,
-    unsigned int maxdecimals,
-    float x,
-    float y,
-    float shadow,
-    float opacity,
-    uint_fast8_t numpadding,
-    uint_fast8_t decimalpadding,
-    NasrColor ** colors,
-    uint_fast8_t palette,
-    uint_fast8_t palette_type
-)
+static int PackAtlasTexture( unsigned int texture, const unsigned char * data, unsigned int width, unsigned int height, int sampling, int indexed, unsigned int channels )
 {
-    if ( charset >= charmaps.capacity || !charmaps.list[ charset ].list )
+    const GLint sample_type = GetGLSamplingType( sampling );
+    const GLint index_type = GetGLRGBA( indexed );
+
+    // Smaller mip levels blur o’er any padding we could afford, so mipmapped textures stay standalone.
+    if ( sample_type == GL_LINEAR_MIPMAP_LINEAR )
     {
         return -1;
     }
 
-    struct NasrGraphic graphic;
-    graphic.scrollx = scrollx;
-    graphic.scrolly = scrolly;
-    graphic.type = NASR_GRAPHIC_COUNTER;
-    graphic.data.counter = calloc( 1, sizeof( NasrGraphicCounter ) );
-    graphic.data.counter->palette = palette;
-    graphic.data.counter->palette_type = palette_type;
-    graphic.data.counter->numpadding = numpadding;
-    graphic.data.counter->decimalpadding = decimalpadding;
-    graphic.data.counter->maxdigits = maxdigits;
-    graphic.data.counter->maxdecimals = maxdecimals;
-    // If no decimals, just have max chars maxdecimals, else have 1 extra for floating point char.
-    int count = maxdigits + ( maxdecimals > 0 ? maxdecimals + 1 : 0 );
-    graphic.data.counter->count = count;
-    graphic.data.counter->maxnum = pow( 10, maxdigits ) - pow( 10, ( int )( -maxdecimals - 1 ) );
-    graphic.data.counter->charset = charset;
-    graphic.data.counter->xoffset = x;
-    graphic.data.counter->yoffset = y;
-    graphic.data.counter->shadow = shadow;
-    graphic.data.counter->opacity = opacity;
-    graphic.data.counter->vaos = calloc( count, sizeof( unsigned int ) );
-    graphic.data.counter->vbos = calloc( count, sizeof( unsigned int ) );
-    graphic.data.counter->vertices = calloc( count * VERTEX_RECT_SIZE, sizeof( float ) );
-    graphic.data.counter->chars = calloc( count, sizeof( NasrChar ) );
-    if ( colors )
+    // Padding on every side keeps linear sampling from bleeding in neighbors’ texels.
+    const unsigned int packw = width + ATLAS_PADDING * 2;
+    const unsigned int packh = height + ATLAS_PADDING * 2;
+    unsigned int x;
+    unsigned int y;
+    AtlasPage * page = 0;
+    for ( unsigned int i = 0; i < atlas_page_count; ++i )
     {
-        for ( int j = 0; j < 4; ++j )
+        if
+        (
+            atlas_pages[ i ].sampling == sample_type
+            && atlas_pages[ i ].indexed == index_type
+            && AtlasPageInsert( &atlas_pages[ i ], packw, packh, &x, &y ) == 0
+        )
         {
-            memcpy( &graphic.data.counter->colors[ j ], colors[ j ], sizeof( NasrColor ) );
+            page = &atlas_pages[ i ];
+            break;
         }
     }
-    const int id = AddGraphic( state, layer, graphic );
-
-    NasrGraphic * g = GetGraphic( id );
-    glGenVertexArrays( count, g->data.counter->vaos );
-    glGenBuffers( count, g->data.counter->vbos );
-
-    // If # goes beyond maxdecimals, make it show all 9s ’stead o’ seeming to loop back round.
-    num = NASR_MATH_MIN( num, graphic.data.counter->maxnum );
-    int intnum = ( int )( floor( num ) );
 
-    for ( int i = 0; i < count; ++i )
+    // If no page has room, start new 1.
+    if ( !page )
     {
-        float * vptr = &g->data.counter->vertices[ i * VERTEX_RECT_SIZE ];
-
-        // Get main digits, then floating point, then decimals.
-        const int c = i == maxdigits ? 10 : ( i > maxdigits ) ? NasrGetDigit( ( int )( floor( num * pow( 10, i - maxdigits ) ) ), 1 ) : NasrGetDigit( intnum, maxdigits - i );
-        CharNum * character = &charmaps.list[ charset ].nums[ c ];
+        if ( atlas_page_count >= MAX_ATLAS_PAGES )
+        {
+            return -1;
+        }
+        GLint max_size;
+        glGetIntegerv( GL_MAX_TEXTURE_SIZE, &max_size );
+        const unsigned int size = NASR_MATH_MIN( ATLAS_PAGE_SIZE, ( unsigned int )( max_size ) );
+        if ( packw > size || packh > size )
+        {
+            return -1;
+        }
 
-        graphic.data.counter->chars[ i ].src = character->src;
-        graphic.data.counter->chars[ i ].dest.x = ( charmaps.list[ charset ].numwidth * i ) + character->xoffset;
-        graphic.data.counter->chars[ i ].dest.y = character->yoffset;
-        graphic.data.counter->chars[ i ].dest.w = character->src.w;
-        graphic.data.counter->chars[ i ].dest.h = character->src.h;
+        AtlasSkylineNode * nodes = malloc( ( size + 1 ) * sizeof( AtlasSkylineNode ) );
+        unsigned char * blank = calloc( ( size_t )( size ) * size, 4 );
+        const int page_texture = nodes && blank ? NasrAddTextureEx( blank, size, size, sampling, indexed ) : -1;
+        free( blank );
+        if ( page_texture < 0 )
+        {
+            NasrLog( "NasrAddAtlasTexture Error: couldn’t create new atlas page." );
+            free( nodes );
+            return -1;
+        }
 
-        glBindVertexArray( g->data.counter->vaos[ i ] );
-        glBindBuffer( GL_ARRAY_BUFFER, g->data.counter->vbos[ i ] );
+        page = &atlas_pages[ atlas_page_count++ ];
+        page->texture = ( unsigned int )( page_texture );
+        page->size = size;
+        page->sampling = sample_type;
+        page->indexed = index_type;
+        page->nodes = nodes;
+        page->nodes[ 0 ].x = page->nodes[ 0 ].y = 0;
+        page->nodes[ 0 ].w = size;
+        page->node_count = 1;
+        AtlasPageInsert( page, packw, packh, &x, &y );
+    }
+    x += ATLAS_PADDING;
+    y += ATLAS_PADDING;
+
+    glBindTexture( GL_TEXTURE_2D, texture_ids[ page->texture ] );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, channels == 1 ? 1 : 4 );
+    glTexSubImage2D( GL_TEXTURE_2D, 0, x, y, width, height, channels == 1 ? GL_RED : GL_RGBA, GL_UNSIGNED_BYTE, data );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    ResetTextureBindings();
+
+    textures[ texture ].width = width;
+    textures[ texture ].height = height;
+    textures[ texture ].indexed = index_type == GL_R8;
+    textures[ texture ].atlas = 1;
+    textures[ texture ].atlas_page = page->texture;
+    textures[ texture ].atlas_x = x;
+    textures[ texture ].atlas_y = y;
+    ++textures[ texture ].version;
+    return 0;
+};
 
-        ResetVertices( vptr );
-        const float texturew = ( float )( charmaps.list[ charset ].texture.width );
-        const float textureh = ( float )( charmaps.list[ charset ].texture.height );
-        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / texturew * character->src.x; // Left X
-        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / texturew * ( character->src.x + character->src.w );  // Right X
-        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / textureh * ( character->src.y + character->src.h ); // Top Y
-        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / textureh * character->src.y;  // Bottom Y
-
-        vptr[ 4 ] = graphic.data.counter->colors[ 3 ].r / 255.0f;
-        vptr[ 5 ] = graphic.data.counter->colors[ 3 ].g / 255.0f;
-        vptr[ 6 ] = graphic.data.counter->colors[ 3 ].b / 255.0f;
-        vptr[ 7 ] = graphic.data.counter->colors[ 3 ].a / 255.0f;
-
-        vptr[ 4 + VERTEX_SIZE ] = graphic.data.counter->colors[ 1 ].r / 255.0f;
-        vptr[ 5 + VERTEX_SIZE ] = graphic.data.counter->colors[ 1 ].g / 255.0f;
-        vptr[ 6 + VERTEX_SIZE ] = graphic.data.counter->colors[ 1 ].b / 255.0f;
-        vptr[ 7 + VERTEX_SIZE ] = graphic.data.counter->colors[ 1 ].a / 255.0f;
-
-        vptr[ 4 + VERTEX_SIZE * 2 ] = graphic.data.counter->colors[ 0 ].r / 255.0f;
-        vptr[ 5 + VERTEX_SIZE * 2 ] = graphic.data.counter->colors[ 0 ].g / 255.0f;
-        vptr[ 6 + VERTEX_SIZE * 2 ] = graphic.data.counter->colors[ 0 ].b / 255.0f;
-        vptr[ 7 + VERTEX_SIZE * 2 ] = graphic.data.counter->colors[ 0 ].a / 255.0f;
-
-        vptr[ 4 + VERTEX_SIZE * 3 ] = graphic.data.counter->colors[ 2 ].r / 255.0f;
-        vptr[ 5 + VERTEX_SIZE * 3 ] = graphic.data.counter->colors[ 2 ].g / 255.0f;
-        vptr[ 6 + VERTEX_SIZE * 3 ] = graphic.data.counter->colors[ 2 ].b / 255.0f;
-        vptr[ 7 + VERTEX_SIZE * 3 ] = graphic.data.counter->colors[ 2 ].a / 255.0f;
-       
-        #undef CHARACTER
+static int QueueTextureLoad( TextureLoadJob * job, const char * filename, int sampling, int indexed )
+{
+    job->filename = ( char * )( malloc( strlen( filename ) + 1 ) );
+    if ( !job->filename )
+    {
+        free( job );
+        return -1;
+    }
+    strcpy( job->filename, filename );
+    job->sampling = sampling;
+    job->indexed = indexed;
+    textures[ job->texture ].loading = 1;
+    textures[ job->texture ].failed = 0;
 
-        BufferDefault( vptr );
+    pthread_mutex_lock( &texture_loader.lock );
+    if ( texture_loader.queued_tail )
+    {
+        texture_loader.queued_tail->next = job;
     }
-    ClearBufferBindings();
+    else
+    {
+        texture_loader.queued = job;
+    }
+    texture_loader.queued_tail = job;
+    pthread_cond_signal( &texture_loader.wake );
+    pthread_mutex_unlock( &texture_loader.lock );
+    return 0;
+};
 
-    return id;
+static void RefreshSpritesForTexture( unsigned int texture )
+{
+    // Sprites’ texture coords depend on texture size, which changes once placeholder is replaced.
+    for ( unsigned int i = 0; i < num_o_graphics; ++i )
+    {
+        if ( graphics[ i ].type == NASR_GRAPHIC_SPRITE && graphics[ i ].data.sprite.texture == texture )
+        {
+            UpdateSpriteVertices( ( unsigned int )( gfx_ptrs_pos_to_id[ i ] ) );
+        }
+    }
 };
 
-static int GraphicAddText
-(
-    float scrollx,
-	float scrolly,
-    unsigned int state,
-    unsigned int layer,
-    NasrText text,
-    NasrColor * top_left_color,
-    NasrColor * top_right_color,
-    NasrColor * bottom_left_color,
-    NasrColor * bottom_right_color,
-    uint_fast8_t palette,
-    uint_fast8_t palette_type
-)
+static void ReleaseTextureSlot( unsigned int texture )
 {
-    if ( text.charset >= charmaps.capacity || !charmaps.list[ text.charset ].list )
+    Texture * t = &textures[ texture ];
+    t->owned = 0;
+    texture_bytes -= t->bytes;
+    t->bytes = 0;
+    glBindTexture( GL_TEXTURE_2D, texture_ids[ texture ] );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0 );
+    ResetTextureBindings();
+
+    // Slots are handed out in order, so only last 1 can be given back for reuse.
+    if ( ( int )( texture ) + 1 == texture_count )
     {
-        return -1;
+        --texture_count;
     }
+};
 
-    // Generate char list from string.
-    float charw = text.coords.w - text.padding_left - text.padding_right;
-    float charh = text.coords.h - text.padding_top - text.padding_bottom;
-    float charx = text.coords.x + text.padding_left;
-    float chary = text.coords.y + text.padding_top;
-    const float lnend = charx + charw;
+static int ReloadEvictedTexture( unsigned int texture )
+{
+    Texture * t = &textures[ texture ];
+    if ( !t->evicted )
+    {
+        return 0;
+    }
 
-    char * string = text.string;
-    CharTemplate letters[ strlen( string ) ];
-    int lettercount = 0;
-    while ( *string )
+    // Pixels are needed right now, so don’t wait on background loader.
+    unsigned int width;
+    unsigned int height;
+    unsigned char * data = LoadTextureFileData( t->filename, &width, &height, t->sampling, t->indexed_type, IsTextureFile( t->filename ) );
+    if ( !data )
     {
-        const int charlen = GetCharacterSize( string );
+        NasrLog( "ReloadEvictedTexture Error: couldn’t reload texture “%s”.", t->filename );
+        return -1;
+    }
+    AddTexture( t, texture_ids[ texture ], data, width, height, t->sampling, t->indexed_type, GetTextureChannels( t->indexed_type ) );
+    free( data );
+    RefreshSpritesForTexture( texture );
+    ResetTextureBindings();
+    return 0;
+};
 
-        // Generate letter string
-        char letter[ charlen + 1 ];
-        strncpy( letter, string, charlen );
-        letter[ charlen ] = 0;
+static void ResetTextureBindings( void )
+{
+    memset( bound_textures, 0, sizeof( bound_textures ) );
+};
 
-        // Find character
-        hash_t needle_hash = CharMapHashString( text.charset, letter );
-        CharMapEntry * entry = CharMapHashFindEntry( text.charset, letter, needle_hash );
-        if ( entry->key.string == NULL )
-        {
-            needle_hash = CharMapHashString( text.charset, "default" );
-            entry = CharMapHashFindEntry( text.charset, "default", needle_hash );
-            if ( entry->key.string )
-            {
-                letters[ lettercount ] = entry->value;
-            }
-        }
-        else
-        {
-            letters[ lettercount ] = entry->value;
-        }
+static void ResetVertices( float * vptr )
+{
+    memcpy( vptr, &vertices_base, sizeof( vertices_base ) );
+};
 
-        ++lettercount;
-        string += charlen;
-    }
-    int maxlines = ( int )( charh );
-    int maxperline = ( int )( charw );
-    CharTemplate lines[ maxlines ][ maxperline ];
-    float line_widths[ maxlines ];
-    line_widths[ 0 ] = 0;
-    int line_character_counts[ maxlines ];
-    int line_count = 0;
-    int line_character = 0;
-    long unsigned int i = 0;
-    int lx = ( int )( charx );
-    int endswithnewline[ maxlines ];
-    while ( i < lettercount )
+static void SetCounterDigits( NasrGraphicCounter * counter, float n )
+{
+    static const uint64_t powers_o_ten[] =
     {
-        long unsigned int ib = i;
-        float xb = lx;
-        int look_ahead = 1;
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+        1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+        1000000000000000000ULL, 10000000000000000000ULL
+    };
+    static const char digit_pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
 
-        // Look ahead so we can know ahead o’ time whether we need to add a new line.
-        // This autobreaks text without cutting midword.
-        while ( look_ahead )
-        {
-            if ( ib >= lettercount )
-            {
-                look_ahead = 0;
-                break;
-            }
+    // If # goes beyond maxdecimals, make it show all 9s ’stead o’ seeming to loop back round.
+    n = NASR_MATH_MIN( n, counter->maxnum );
+    if ( !( n > 0.0f ) )
+    {
+        n = 0.0f;
+    }
 
-            if ( letters[ ib ].chartype == NASR_CHAR_NEWLINE )
-            {
-                look_ahead = 0;
-            }
-            else if ( letters[ ib ].chartype == NASR_CHAR_WHITESPACE )
-            {
-                look_ahead = 0;
-            }
-            else if ( xb >= lnend )
-            {
-                lx = ( int )( charx );
-                line_character_counts[ line_count ] = line_character;
-                endswithnewline[ line_count ] = 0;
-                ++line_count;
-                line_widths[ line_count ] = 0;
-                line_character = 0;
-                look_ahead = 0;
-            }
-            else if ( ib >= lettercount )
-            {
-                look_ahead = 0;
-                break;
-            }
-            xb += letters[ ib ].src.w;
-            ++ib;
-        }
+    // Convert once to scaled integer so integer & decimal digits come from the same #.
+    // Nudge up by float’s relative error so 0.7f, stored as 0.69999…, still shows 7.
+    const unsigned int maxdigits = counter->maxdigits;
+    const unsigned int decimals = NASR_MATH_MIN( counter->maxdecimals, 19 );
+    const double scaled = ( double )( n ) * ( double )( powers_o_ten[ decimals ] );
+    uint64_t intnum;
+    uint64_t decnum = 0;
+    if ( scaled < 18446744073709551615.0 )
+    {
+        const uint64_t v = ( uint64_t )( scaled + scaled * FLT_EPSILON );
+        intnum = v / powers_o_ten[ decimals ];
+        decnum = v % powers_o_ten[ decimals ];
+    }
+    else
+    {
+        intnum = ( double )( n ) < 18446744073709551615.0 ? ( uint64_t )( n ) : UINT64_MAX;
+    }
 
-        while ( i < ib )
+    // Fill main digits from right, 2 @ a time.
+    GLint * d = &counter->digits[ maxdigits ];
+    GLint * const intstart = counter->digits;
+    while ( intnum >= 100 && d - intstart >= 2 )
+    {
+        const unsigned int r = ( unsigned int )( intnum % 100 ) * 2;
+        intnum /= 100;
+        *--d = digit_pairs[ r + 1 ] - '0';
+        *--d = digit_pairs[ r ] - '0';
+    }
+    do
+    {
+        if ( d == intstart )
         {
-            if ( letters[ i ].chartype == NASR_CHAR_NEWLINE || lx >= lnend )
-            {
-                lx = ( int )( charx );
-                line_character_counts[ line_count ] = line_character;
-                endswithnewline[ line_count ] = letters[ i ].chartype == NASR_CHAR_NEWLINE;
-                ++line_count;
-                line_widths[ line_count ] = 0;
-                line_character = 0;
-            }
-            else
-            {
-                lines[ line_count ][ line_character ] = letters[ i ];
-                line_widths[ line_count ] += letters[ i ].src.w;
-                ++line_character;
-                lx += letters[ i ].src.w;
-            }
-            ++i;
+            break;
         }
+        *--d = ( GLint )( intnum % 10 );
+        intnum /= 10;
     }
-    line_character_counts[ line_count ] = line_character;
-    ++line_count;
+    while ( intnum );
 
-    int finalcharcount = 0;
-    float maxh[ line_count ];
+    // Leading zeros are blank unless number padding is on.
+    const GLint lead = counter->numpadding ? 0 : COUNTER_BLANK;
+    while ( d > intstart )
+    {
+        *--d = lead;
+    }
 
-    for ( int l = 0; l < line_count; ++l )
+    if ( counter->count <= maxdigits )
     {
-        finalcharcount += line_character_counts[ l ];
+        return;
+    }
 
-        maxh[ l ] = 8.0f;
-        for ( int c = 0; c < line_character_counts[ l ]; ++c )
+    // Floating point, then decimals, also filled from right.
+    counter->digits[ maxdigits ] = COUNTER_POINT;
+    GLint * const decstart = &counter->digits[ maxdigits + 1 ];
+    d = &counter->digits[ counter->count ];
+    while ( d - decstart > decimals )
+    {
+        *--d = 0;
+    }
+    while ( d - decstart >= 2 )
+    {
+        const unsigned int r = ( unsigned int )( decnum % 100 ) * 2;
+        decnum /= 100;
+        *--d = digit_pairs[ r + 1 ] - '0';
+        *--d = digit_pairs[ r ] - '0';
+    }
+    if ( d > decstart )
+    {
+        *--d = ( GLint )( decnum % 10 );
+    }
+
+    // Trailing zeros are blank unless decimal padding is on; drop point too if no decimals left.
+    if ( !counter->decimalpadding )
+    {
+        GLint * e = &counter->digits[ counter->count ];
+        while ( e > decstart && e[ -1 ] == 0 )
         {
-            if ( lines[ l ][ c ].src.h > maxh[ l ] )
-            {
-                maxh[ l ] = lines[ l ][ c ].src.h;
-            }
+            *--e = COUNTER_BLANK;
         }
-
-        // Sometimes the previous loop keeps whitespace @ the end o’ lines.
-        // Since this messes with x alignment, remove these.
-        if ( lines[ l ][ line_character_counts[ l ] - 1 ].chartype == NASR_CHAR_WHITESPACE )
+        if ( e == decstart )
         {
-            --line_character_counts[ l ];
-            line_widths[ l ] -= lines[ l ][ line_character_counts[ l ] - 1 ].src.w;
+            counter->digits[ maxdigits ] = COUNTER_BLANK;
         }
     }
+};
 
-    NasrChar chars[ finalcharcount ];
-    int count = 0;
-    // Final loop: we have all the info we need now to set x & y positions.
-    float dy = ( text.valign == NASR_VALIGN_MIDDLE )
-        ? chary + ( ( charh - ( line_count * 8.0 ) ) / 2.0 )
-        : ( text.valign == NASR_VALIGN_BOTTOM )
-            ? chary + charh - ( line_count * 8.0 )
-            : chary;
-    for ( int l = 0; l < line_count; ++l )
+static void SetShader( unsigned int shader )
+{
+    if ( current_shader != shader )
     {
-        float dx = ( text.align == NASR_ALIGN_CENTER )
-            ? charx + ( ( charw - line_widths[ l ] ) / 2.0 )
-            : ( text.align == NASR_ALIGN_RIGHT )
-                ? lnend - line_widths[ l ]
-                : charx;
+        glUseProgram( shader );
+        current_shader = shader;
+    }
+};
 
-        // Add justified spacing if set to justified & not an endline.
-        float letterspace = text.align == NASR_ALIGN_JUSTIFIED && line_character_counts[ l ] > 0 && l < line_count - 1 && !endswithnewline[ l ]
-            ? ( charw - line_widths[ l ] ) / ( float )( line_character_counts[ l ] - 1 )
-            : 0.0f;
+static void SetSpriteAtlasRect( const SpriteUniforms * uniforms, unsigned int texture )
+{
+    // Tiling must wrap within texture’s own spot in its page, not o’er whole page; 0 size means no atlas.
+    const Texture * t = &textures[ texture ];
+    if ( !t->atlas )
+    {
+        glUniform4f( uniforms->atlas_rect, 0.0f, 0.0f, 0.0f, 0.0f );
+        return;
+    }
+    const Texture * page = &textures[ t->atlas_page ];
+    glUniform4f
+    (
+        uniforms->atlas_rect,
+        ( float )( t->atlas_x ) / ( float )( page->width ),
+        ( float )( t->atlas_y ) / ( float )( page->height ),
+        ( float )( t->width ) / ( float )( page->width ),
+        ( float )( t->height ) / ( float )( page->height )
+    );
+};
 
-        for ( int c = 0; c < line_character_counts[ l ]; ++c )
-        {
-            // Just in case o’ character index misalignment, just copy o’er whole characters.
-            if ( lines[ l ][ c ].chartype != NASR_CHAR_WHITESPACE ) {
-                chars[ count ].src = lines[ l ][ c ].src;
-                chars[ count ].dest = lines[ l ][ c ].src;
-                chars[ count ].dest.x = dx;
-                chars[ count ].dest.y = dy + ( ( maxh[ l ] - lines[ l ][ c ].src.h ) / 2.0 );
-                ++count;
-            }
-            if ( lines[ l ][ c ].src.w > 0.0f ) {
-                dx += ( lines[ l ][ c ].src.w + letterspace );
-            }
-        }
-        dy += maxh[ l ];
+static void SetTextureFilters( GLenum target, GLint sampling, int mipmapped )
+{
+    // Mipmap modes are only valid for minifying; magnifying just blends base level.
+    // Textures that asked for mipmaps but can’t have them are indexed, so they stay unfiltered.
+    const GLint base = sampling == GL_LINEAR_MIPMAP_LINEAR ? ( mipmapped ? GL_LINEAR : GL_NEAREST ) : sampling;
+    glTexParameteri( target, GL_TEXTURE_MIN_FILTER, mipmapped ? GL_LINEAR_MIPMAP_LINEAR : base );
+    glTexParameteri( target, GL_TEXTURE_MAG_FILTER, base );
+    if ( texture_anisotropy > 1.0f )
+    {
+        glTexParameterf( target, GL_TEXTURE_MAX_ANISOTROPY_EXT, mipmapped ? texture_anisotropy : 1.0f );
     }
+};
 
-    // End charlist
+static void SetTextureSource( unsigned int texture, const char * filename, int sampling, int indexed )
+{
+    // Remember where texture came from so it can be evicted & reloaded later.
+    Texture * t = &textures[ texture ];
+    free( t->filename );
+    t->filename = ( char * )( malloc( strlen( filename ) + 1 ) );
+    t->evictable = t->filename != 0;
+    if ( t->filename )
+    {
+        strcpy( t->filename, filename );
+    }
+    t->sampling = sampling;
+    t->indexed_type = indexed;
+};
 
-    struct NasrGraphic graphic;
-    graphic.scrollx = scrollx;
-    graphic.scrolly = scrolly;
-    graphic.type = NASR_GRAPHIC_TEXT;
-    graphic.data.text.charset = text.charset;
-    graphic.data.text.palette = palette;
-    graphic.data.text.palette_type = palette_type;
-    graphic.data.text.capacity = graphic.data.text.count = count;
-    graphic.data.text.xoffset = text.xoffset;
-    graphic.data.text.yoffset = text.yoffset;
-    graphic.data.text.shadow = text.shadow;
-    graphic.data.text.opacity = text.opacity;
-    graphic.data.text.vaos = calloc( count, sizeof( unsigned int ) );
-    graphic.data.text.vbos = calloc( count, sizeof( unsigned int ) );
-    graphic.data.text.vertices = calloc( count * VERTEX_RECT_SIZE, sizeof( float ) );
-    graphic.data.text.chars = calloc( count, sizeof( NasrChar ) );
-    memcpy( graphic.data.text.chars, chars, count * sizeof( NasrChar ) );
-    const int id = AddGraphic( state, layer, graphic );
+static void SetTilemapTextureData( unsigned int texture_id, const unsigned char * data, unsigned int width, unsigned int height )
+{
+    // Tiles are kept as unsigned integers so shaders can read them exactly with texelFetch.
+    glBindTexture( GL_TEXTURE_2D, texture_id );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8UI, width, height, 0, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, data );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+};
 
-    NasrGraphic * g = GetGraphic( id );
-    glGenVertexArrays( count, g->data.text.vaos );
-    glGenBuffers( count, g->data.text.vbos );
+static void SetVerticesColors( unsigned int id, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color )
+{
+    BindBuffers( id );
+    float * vptr = GetVertices( id );
+    SetVerticesColorValues( vptr, top_left_color, top_right_color, bottom_left_color, bottom_right_color );
+    ClearBufferBindings();
+};
 
-    for ( int i = 0; i < count; ++i )
-    {
-        float * vptr = &g->data.text.vertices[ i * VERTEX_RECT_SIZE ];
-        #define CHARACTER g->data.text.chars[ i ]
+static void SetVerticesColorValues( float * vptr, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color )
+{
+    FillVerticesColorValues( vptr, top_left_color, top_right_color, bottom_left_color, bottom_right_color );
+    BufferVertices( vptr );
+};
 
-        glBindVertexArray( g->data.text.vaos[ i ] );
-        glBindBuffer( GL_ARRAY_BUFFER, g->data.text.vbos[ i ] );
+static void SetVerticesView( float x, float y, float scrollx, float scrolly )
+{
+    x += camera.x * scrollx;
+    y += camera.y * scrolly;
+    mat4 view = BASE_MATRIX;
+    vec3 trans = { x, y, 0.0f };
+    glm_translate( view, trans );
+    unsigned int view_location = glGetUniformLocation( current_shader, "view" );
+    glUniformMatrix4fv( view_location, 1, GL_FALSE, ( float * )( view ) );
+};
 
-        ResetVertices( vptr );
-        const float texturew = ( float )( charmaps.list[ text.charset ].texture.width );
-        const float textureh = ( float )( charmaps.list[ text.charset ].texture.height );
-        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / texturew * CHARACTER.src.x; // Left X
-        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / texturew * ( CHARACTER.src.x + CHARACTER.src.w );  // Right X
-        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / textureh * ( CHARACTER.src.y + CHARACTER.src.h ); // Top Y
-        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / textureh * CHARACTER.src.y;  // Bottom Y
+static void SetupVertices( unsigned int vao )
+{
+    glDrawElements( GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0 );
+};
 
-        if ( bottom_right_color )
+static int StartTextureLoader( void )
+{
+    if ( pthread_mutex_init( &texture_loader.lock, 0 ) != 0 || pthread_cond_init( &texture_loader.wake, 0 ) != 0 )
+    {
+        NasrLog( "StartTextureLoader Error: couldn’t set up texture loader." );
+        return -1;
+    }
+    texture_loader.quit = 0;
+    texture_loader.thread_count = 0;
+    for ( unsigned int i = 0; i < TEXTURE_LOAD_THREADS; ++i )
+    {
+        if ( pthread_create( &texture_loader.threads[ i ], 0, TextureLoaderWork, 0 ) != 0 )
         {
-            vptr[ 4 ] = bottom_right_color->r / 255.0f;
-            vptr[ 5 ] = bottom_right_color->g / 255.0f;
-            vptr[ 6 ] = bottom_right_color->b / 255.0f;
-            vptr[ 7 ] = bottom_right_color->a / 255.0f;
+            break;
+        }
+        ++texture_loader.thread_count;
+    }
+    if ( texture_loader.thread_count == 0 )
+    {
+        NasrLog( "StartTextureLoader Error: couldn’t start any texture loading threads." );
+        pthread_cond_destroy( &texture_loader.wake );
+        pthread_mutex_destroy( &texture_loader.lock );
+        return -1;
+    }
+    texture_loader.running = 1;
+    return 0;
+};
 
-            vptr[ 4 + VERTEX_SIZE ] = top_right_color->r / 255.0f;
-            vptr[ 5 + VERTEX_SIZE ] = top_right_color->g / 255.0f;
-            vptr[ 6 + VERTEX_SIZE ] = top_right_color->b / 255.0f;
-            vptr[ 7 + VERTEX_SIZE ] = top_right_color->a / 255.0f;
+static void StopTextureLoader( void )
+{
+    if ( !texture_loader.running )
+    {
+        return;
+    }
 
-            vptr[ 4 + VERTEX_SIZE * 2 ] = top_left_color->r / 255.0f;
-            vptr[ 5 + VERTEX_SIZE * 2 ] = top_left_color->g / 255.0f;
-            vptr[ 6 + VERTEX_SIZE * 2 ] = top_left_color->b / 255.0f;
-            vptr[ 7 + VERTEX_SIZE * 2 ] = top_left_color->a / 255.0f;
+    pthread_mutex_lock( &texture_loader.lock );
+    texture_loader.quit = 1;
+    pthread_cond_broadcast( &texture_loader.wake );
+    pthread_mutex_unlock( &texture_loader.lock );
+    for ( unsigned int i = 0; i < texture_loader.thread_count; ++i )
+    {
+        pthread_join( texture_loader.threads[ i ], 0 );
+    }
+
+    TextureLoadJob * lists[ 3 ] = { texture_loader.queued, texture_loader.done, texture_loader.waiters };
+    for ( int i = 0; i < 3; ++i )
+    {
+        while ( lists[ i ] )
+        {
+            TextureLoadJob * next = lists[ i ]->next;
+            free( lists[ i ]->data );
+            free( lists[ i ]->filename );
+            free( lists[ i ] );
+            lists[ i ] = next;
+        }
+    }
+    texture_loader.queued = texture_loader.queued_tail = 0;
+    texture_loader.done = texture_loader.done_tail = 0;
+    texture_loader.waiters = 0;
+    pthread_cond_destroy( &texture_loader.wake );
+    pthread_mutex_destroy( &texture_loader.lock );
+    texture_loader.running = 0;
+};
+
+static void * TextureLoaderWork( void * arg )
+{
+    // Workers only decode files; all GL work stays on main thread in FinishTextureLoads.
+    pthread_mutex_lock( &texture_loader.lock );
+    while ( 1 )
+    {
+        while ( !texture_loader.queued && !texture_loader.quit )
+        {
+            pthread_cond_wait( &texture_loader.wake, &texture_loader.lock );
+        }
+        if ( texture_loader.quit )
+        {
+            break;
+        }
 
-            vptr[ 4 + VERTEX_SIZE * 3 ] = bottom_left_color->r / 255.0f;
-            vptr[ 5 + VERTEX_SIZE * 3 ] = bottom_left_color->g / 255.0f;
-            vptr[ 6 + VERTEX_SIZE * 3 ] = bottom_left_color->b / 255.0f;
-            vptr[ 7 + VERTEX_SIZE * 3 ] = bottom_left_color->a / 255.0f;
+        TextureLoadJob * job = texture_loader.queued;
+        texture_loader.queued = job->next;
+        if ( !texture_loader.queued )
+        {
+            texture_loader.queued_tail = 0;
         }
-       
-        #undef CHARACTER
+        job->next = 0;
+        pthread_mutex_unlock( &texture_loader.lock );
 
-        BufferDefault( vptr );
-    }
-    ClearBufferBindings();
+        job->data = LoadTextureFileData( job->filename, &job->width, &job->height, job->sampling, job->indexed, IsTextureFile( job->filename ) );
 
-    return id;
+        pthread_mutex_lock( &texture_loader.lock );
+        if ( texture_loader.done_tail )
+        {
+            texture_loader.done_tail->next = job;
+        }
+        else
+        {
+            texture_loader.done = job;
+        }
+        texture_loader.done_tail = job;
+    }
+    pthread_mutex_unlock( &texture_loader.lock );
+    return 0;
 };
 
-static void GraphicsRectGradientPaletteUpdateColors( unsigned int id, uint_fast8_t * c )
+static int TextureMapGrow( void )
 {
-    NasrColor cobj[ 4 ];
-    for ( int i = 0; i < 4; ++i )
+    const uint32_t prev_size = texture_map_size;
+    TextureMapEntry * prev_map = texture_map;
+    TextureMapEntry * new_map = calloc( prev_size * 2, sizeof( TextureMapEntry ) );
+    if ( !new_map )
     {
-        cobj[ i ].r = ( float )( c[ i ] );
-        cobj[ i ].a = 255.0f;
+        return -1;
     }
-    ResetVertices( GetVertices( id ) );
-    SetVerticesColors( id, &cobj[ 0 ], &cobj[ 1 ], &cobj[ 2 ], &cobj[ 3 ] );
+    texture_map = new_map;
+    texture_map_size = prev_size * 2;
+    for ( uint32_t i = 0; i < prev_size; ++i )
+    {
+        if ( prev_map[ i ].distance )
+        {
+            TextureMapInsert( prev_map[ i ] );
+        }
+    }
+    free( prev_map );
+    return 0;
 };
 
-static void GraphicsUpdateRectPalette( unsigned int id, uint_fast8_t color )
+static hash_t TextureMapHashString( const char * key, uint32_t * length )
 {
-    NasrColor c =
+    // Full FNV-1a hash, measuring string in same pass.
+    hash_t hash = 2166136261u;
+    uint32_t i = 0;
+    for ( ; key[ i ]; ++i )
     {
-        ( float )( color ),
-        0.0f,
-        0.0f,
-        255.0f
-    };
-    ResetVertices( GetVertices( id ) );
-    SetVerticesColors( id, &c, &c, &c, &c );
+        hash ^= ( uint8_t )( key[ i ] );
+        hash *= 16777619;
+    }
+    *length = i;
+    return hash;
 };
 
-static int GrowGraphics( void )
+static void TextureMapInsert( TextureMapEntry entry )
 {
-    const unsigned int new_max_graphics = max_graphics * 2;
-    const unsigned int size_diff = new_max_graphics - max_graphics;
-
-    unsigned int * new_vaos = calloc( ( new_max_graphics + 1 ), sizeof( unsigned int ) );
-    unsigned int * new_vbos = calloc( ( new_max_graphics + 1 ), sizeof( unsigned int ) );
-    float * new_vertices = calloc( ( new_max_graphics + 1 ) * VERTEX_RECT_SIZE, sizeof( float ) );
-    NasrGraphic * new_graphics = calloc( new_max_graphics, sizeof( NasrGraphic ) );
-    int * new_gfx_ptrs_id_to_pos = calloc( new_max_graphics, sizeof( int ) );
-    int * new_gfx_ptrs_pos_to_id = calloc( new_max_graphics, sizeof( int ) );
-    int * new_state_for_gfx = calloc( new_max_graphics, sizeof( int ) );
-    int * new_layer_for_gfx = calloc( new_max_graphics, sizeof( int ) );
-    if
-    (
-        !new_vaos ||
-        !new_vbos ||
-        !new_vertices ||
-        !new_graphics ||
-        !new_gfx_ptrs_id_to_pos ||
-        !new_gfx_ptrs_pos_to_id ||
-        !new_state_for_gfx ||
-        !new_layer_for_gfx
-    )
+    // Robin Hood: entry takes slot from any entry that’s closer to its home slot, which then moves on in its place.
+    const uint32_t mask = texture_map_size - 1;
+    uint32_t pos = entry.hash & mask;
+    entry.distance = 1;
+    while ( texture_map[ pos ].distance )
     {
-        NasrLog( "AddGraphic Error: ¡Not ’nough memory for graphics!" );
-        return 0;
+        if ( texture_map[ pos ].distance < entry.distance )
+        {
+            const TextureMapEntry t = texture_map[ pos ];
+            texture_map[ pos ] = entry;
+            entry = t;
+        }
+        pos = ( pos + 1 ) & mask;
+        ++entry.distance;
     }
+    texture_map[ pos ] = entry;
+};
 
-    memcpy( new_vaos, vaos, ( max_graphics + 1 ) * sizeof( unsigned int ) );
-    memcpy( new_vbos, vbos, ( max_graphics + 1 ) * sizeof( unsigned int ) );
-    memcpy( new_vertices, vertices, ( max_graphics + 1 ) * VERTEX_RECT_SIZE * sizeof( float ) );
-    memcpy( new_graphics, graphics, max_graphics * sizeof( NasrGraphic ) );
-    memcpy( new_gfx_ptrs_id_to_pos, gfx_ptrs_id_to_pos, max_graphics * sizeof( int ) );
-    memcpy( new_gfx_ptrs_pos_to_id, gfx_ptrs_pos_to_id, max_graphics * sizeof( int ) );
-    memcpy( new_state_for_gfx, state_for_gfx, max_graphics * sizeof( int ) );
-    memcpy( new_layer_for_gfx, layer_for_gfx, max_graphics * sizeof( int ) );
-
-    free( vaos );
-    free( vbos );
-    free( vertices );
-    free( graphics );
-    free( gfx_ptrs_id_to_pos );
-    free( gfx_ptrs_pos_to_id );
-    free( state_for_gfx );
-    free( layer_for_gfx );
+static int TextureMapLookup( const char * filename, unsigned int value )
+{
+    // Returns texture already mapped to filename, or maps filename to value & returns -1 if there isn’t one.
+    uint32_t length;
+    const hash_t hash = TextureMapHashString( filename, &length );
 
-    vaos = new_vaos;
-    vbos = new_vbos;
-    vertices = new_vertices;
-    graphics = new_graphics;
-    gfx_ptrs_id_to_pos = new_gfx_ptrs_id_to_pos;
-    gfx_ptrs_pos_to_id = new_gfx_ptrs_pos_to_id;
-    state_for_gfx = new_state_for_gfx;
-    layer_for_gfx = new_layer_for_gfx;
+    // Stored hashes mean strings only get compared when they almost surely match. Once we pass entry closer
+    // to its home slot than we are to ours, Robin Hood ordering means filename can’t be further on.
+    const uint32_t mask = texture_map_size - 1;
+    uint32_t pos = hash & mask;
+    for ( uint32_t distance = 1; texture_map[ pos ].distance >= distance; ++distance )
+    {
+        const TextureMapEntry * entry = &texture_map[ pos ];
+        if ( entry->hash == hash && entry->length == length && memcmp( &texture_names[ entry->key ], filename, length ) == 0 )
+        {
+            return ( int )( entry->value );
+        }
+        pos = ( pos + 1 ) & mask;
+    }
 
-    glGenVertexArrays( size_diff, &vaos[ max_graphics + 1 ] );
-    glGenBuffers( size_diff, &vbos[ max_graphics + 1 ] );
-    for ( int i = max_graphics + 1; i < new_max_graphics + 1; ++i )
+    // Keep table under ¾ full so probes stay short.
+    if ( ( texture_map_count + 1 ) * 4 > texture_map_size * 3 && TextureMapGrow() != 0 )
     {
-        float * vptr = GetVertices( i );
-        ResetVertices( vptr );
-        BindBuffers( i );
-        BufferDefault( vptr );
+        NasrLog( "NasrLoadFileAsTextureEx Error: ¡Not ’nough memory to remember “%s”!", filename );
+        return -1;
     }
-    ClearBufferBindings();
 
-    // Initialize these to null values ( since 0 is a valid value, we use -1 ).
-    for ( int i = max_graphics; i < new_max_graphics; ++i )
+    // Intern name in arena.
+    if ( texture_names_size + length + 1 > texture_names_capacity )
     {
-        gfx_ptrs_id_to_pos[ i ] = gfx_ptrs_pos_to_id[ i ] = state_for_gfx[ i ] = layer_for_gfx[ i ] = -1;
+        size_t capacity = NASR_MATH_MAX( texture_names_capacity * 2, TEXTURE_NAMES_MIN_SIZE );
+        while ( capacity < texture_names_size + length + 1 )
+        {
+            capacity *= 2;
+        }
+        char * names = realloc( texture_names, capacity );
+        if ( !names )
+        {
+            NasrLog( "NasrLoadFileAsTextureEx Error: ¡Not ’nough memory to remember “%s”!", filename );
+            return -1;
+        }
+        texture_names = names;
+        texture_names_capacity = capacity;
     }
+    memcpy( &texture_names[ texture_names_size ], filename, length + 1 );
 
-    max_graphics = new_max_graphics;
-    return 1;
+    TextureMapEntry entry;
+    entry.hash = hash;
+    entry.key = ( uint32_t )( texture_names_size );
+    entry.length = length;
+    entry.value = value;
+    texture_names_size += length + 1;
+    TextureMapInsert( entry );
+    ++texture_map_count;
+    return -1;
 };
 
-static unsigned char * LoadTextureFileData( const char * filename, unsigned int * width, unsigned int * height, int sampling, int indexed )
+static void TextureMapRemove( const char * filename )
 {
-    int channels;
-    int w;
-    int h;
-    unsigned char * data = stbi_load( filename, &w, &h, &channels, STBI_rgb_alpha );
-    if ( data == NULL || w < 0 || h < 0 )
+    uint32_t length;
+    const hash_t hash = TextureMapHashString( filename, &length );
+    const uint32_t mask = texture_map_size - 1;
+    uint32_t pos = hash & mask;
+    for ( uint32_t distance = 1; texture_map[ pos ].distance >= distance; ++distance )
     {
-        NasrLog( "Couldn’t load texture file “%s”.", filename );
-        return 0;
+        const TextureMapEntry * entry = &texture_map[ pos ];
+        if ( entry->hash == hash && entry->length == length && memcmp( &texture_names[ entry->key ], filename, length ) == 0 )
+        {
+            // Shift following entries back a slot till 1 is already home, so no probe chain gets broken.
+            uint32_t next = ( pos + 1 ) & mask;
+            while ( texture_map[ next ].distance > 1 )
+            {
+                texture_map[ pos ] = texture_map[ next ];
+                --texture_map[ pos ].distance;
+                pos = next;
+                next = ( next + 1 ) & mask;
+            }
+            memset( &texture_map[ pos ], 0, sizeof( TextureMapEntry ) );
+            --texture_map_count;
+            return;
+        }
+        pos = ( pos + 1 ) & mask;
     }
-    *width = w;
-    *height = h;
-    return data;
 };
 
-static void ResetVertices( float * vptr )
+static int TextureMipmapped( GLint sampling, GLint indexed )
 {
-    memcpy( vptr, &vertices_base, sizeof( vertices_base ) );
+    // Palette indices can’t be averaged, so indexed textures fall back to nearest sampling.
+    return sampling == GL_LINEAR_MIPMAP_LINEAR && indexed != GL_R8;
 };
 
-static void SetShader( unsigned int shader )
+static int TilemapHasAnimatedTiles( const NasrGraphicTilemap * tilemap )
 {
-    if ( current_shader != shader )
+    const size_t count = ( size_t )( textures[ tilemap->tilemap ].width ) * textures[ tilemap->tilemap ].height;
+    for ( size_t i = 0; i < count; ++i )
     {
-        glUseProgram( shader );
-        current_shader = shader;
+        const unsigned char animation = tilemap->data[ i * 4 + 3 ];
+        if ( animation > 0 && animation < 255 )
+        {
+            return 1;
+        }
     }
+    return 0;
 };
 
-static void SetVerticesColors( unsigned int id, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color )
+static int TilemapSolidAt( const NasrGraphicTilemap * tilemap, int x, int y )
 {
-    BindBuffers( id );
-    float * vptr = GetVertices( id );
-    SetVerticesColorValues( vptr, top_left_color, top_right_color, bottom_left_color, bottom_right_color );
-    ClearBufferBindings();
+    return ( tilemap->solid[ ( size_t )( y ) * tilemap->solid_stride + x / 64 ] >> ( x % 64 ) ) & 1;
 };
 
-static void SetVerticesColorValues( float * vptr, const NasrColor * top_left_color, const NasrColor * top_right_color, const NasrColor * bottom_left_color, const NasrColor * bottom_right_color )
+static void TouchTexture( unsigned int texture )
 {
-    vptr[ 4 ] = bottom_right_color->r / 255.0f;
-    vptr[ 5 ] = bottom_right_color->g / 255.0f;
-    vptr[ 6 ] = bottom_right_color->b / 255.0f;
-    vptr[ 7 ] = bottom_right_color->a / 255.0f;
-
-    vptr[ 4 + VERTEX_SIZE ] = top_right_color->r / 255.0f;
-    vptr[ 5 + VERTEX_SIZE ] = top_right_color->g / 255.0f;
-    vptr[ 6 + VERTEX_SIZE ] = top_right_color->b / 255.0f;
-    vptr[ 7 + VERTEX_SIZE ] = top_right_color->a / 255.0f;
-
-    vptr[ 4 + VERTEX_SIZE * 2 ] = top_left_color->r / 255.0f;
-    vptr[ 5 + VERTEX_SIZE * 2 ] = top_left_color->g / 255.0f;
-    vptr[ 6 + VERTEX_SIZE * 2 ] = top_left_color->b / 255.0f;
-    vptr[ 7 + VERTEX_SIZE * 2 ] = top_left_color->a / 255.0f;
-
-    vptr[ 4 + VERTEX_SIZE * 3 ] = bottom_left_color->r / 255.0f;
-    vptr[ 5 + VERTEX_SIZE * 3 ] = bottom_left_color->g / 255.0f;
-    vptr[ 6 + VERTEX_SIZE * 3 ] = bottom_left_color->b / 255.0f;
-    vptr[ 7 + VERTEX_SIZE * 3 ] = bottom_left_color->a / 255.0f;
+    Texture * t = &textures[ texture ];
+    t->last_used = texture_frame;
 
-    BufferVertices( vptr );
+    // Bring evicted texture back in background; it draws blank till it’s ready.
+    if ( t->evicted && !t->loading )
+    {
+        if ( !texture_loader.running && StartTextureLoader() != 0 )
+        {
+            return;
+        }
+        TextureLoadJob * job = calloc( 1, sizeof( TextureLoadJob ) );
+        if ( !job )
+        {
+            return;
+        }
+        job->texture = texture;
+        job->generation = texture_generation;
+        if ( QueueTextureLoad( job, t->filename, t->sampling, t->indexed_type ) != 0 )
+        {
+            NasrLog( "NasrUpdate Error: couldn’t reload texture “%s”.", t->filename );
+        }
+    }
 };
 
-static void SetVerticesView( float x, float y, float scrollx, float scrolly )
+static void UpdateAnimationFrames( void )
 {
-    x += camera.x * scrollx;
-    y += camera.y * scrolly;
-    mat4 view = BASE_MATRIX;
-    vec3 trans = { x, y, 0.0f };
-    glm_translate( view, trans );
-    unsigned int view_location = glGetUniformLocation( rect_shader, "view" );
-    glUniformMatrix4fv( view_location, 1, GL_FALSE, ( float * )( view ) );
-};
+    // Work out current frame for every possible frame count once here so tilemap shaders can just look it up.
+    unsigned char frames[ 256 ] = { 0 };
+    for ( unsigned int i = 1; i < 256; ++i )
+    {
+        frames[ i ] = ( unsigned char )( animation_frame % i );
+    }
+    glBindTexture( GL_TEXTURE_2D, animation_frames_texture_id );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RED_INTEGER, GL_UNSIGNED_BYTE, frames );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
 
-static void SetupVertices( unsigned int vao )
-{
-    glDrawElements( GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0 );
+    // Tilesets with their own animation tables advance @ same time.
+    for ( int i = 0; i < texture_count; ++i )
+    {
+        if ( textures[ i ].animations )
+        {
+            UpdateTileAnimationTable( textures[ i ].animations );
+        }
+    }
 };
 
-static uint32_t TextureMapHashString( const char * key )
+static void UpdateCharVertices( float * vptr, const NasrRect * src, const Texture * texture )
 {
-    return NasrHashString( key, texture_map_size );
+    const float texturew = ( float )( texture->width );
+    const float textureh = ( float )( texture->height );
+    vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / texturew * src->x; // Left X
+    vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / texturew * ( src->x + src->w );  // Right X
+    vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / textureh * ( src->y + src->h ); // Top Y
+    vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / textureh * src->y;  // Bottom Y
 };
 
 static void UpdateShaderOrtho( float x, float y, float w, float h )
 {
-    for ( int i = 0; i < NUMBER_O_BASE_SHADERS; ++i )
+    // Remember view so tilemap programs built later can be given same ortho.
+    ortho_view.x = x;
+    ortho_view.y = y;
+    ortho_view.w = w;
+    ortho_view.h = h;
+
+    mat4 ortho =
     {
-        const unsigned int shader = *base_shaders[ i ];
-        SetShader( shader );
-        mat4 ortho =
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f }
+    };
+    glm_ortho_rh_no( x, w, h, y, -1.0f, 1.0f, ortho );
+
+    const unsigned int shadersnum = NUMBER_O_BASE_SHADERS + tilemap_program_count * 3;
+    for ( unsigned int i = 0; i < shadersnum; ++i )
+    {
+        unsigned int shader;
+        if ( i < NUMBER_O_BASE_SHADERS )
         {
-            { 1.0f, 1.0f, 1.0f, 1.0f },
-            { 1.0f, 1.0f, 1.0f, 1.0f },
-            { 1.0f, 1.0f, 1.0f, 1.0f },
-            { 1.0f, 1.0f, 1.0f, 1.0f }
-        };
-        glm_ortho_rh_no( x, w, h, y, -1.0f, 1.0f, ortho );
+            shader = *base_shaders[ i ];
+        }
+        else
+        {
+            const TilemapProgram * program = &tilemap_programs[ ( i - NUMBER_O_BASE_SHADERS ) / 3 ];
+            const unsigned int program_shaders[ 3 ] = { program->shader, program->mono_shader, program->layered_shader };
+            shader = program_shaders[ ( i - NUMBER_O_BASE_SHADERS ) % 3 ];
+        }
+        SetShader( shader );
         unsigned int ortho_location = glGetUniformLocation( shader, "ortho" );
         glUniformMatrix4fv( ortho_location, 1, GL_FALSE, ( float * )( ortho ) );
     }
@@ -6958,27 +11681,28 @@ static void UpdateSpriteVertices( unsigned int id )
 
 static void UpdateSpriteVerticesValues( float * vptr, const NasrGraphicSprite * sprite )
 {
-    const unsigned int texture_id = sprite->texture;
+    float left, right, top, bottom;
+    GetSpriteTextureCoords( sprite, &left, &right, &top, &bottom );
     if ( sprite->flip_x )
     {
-        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].width ) * sprite->src.x; // Left X
-        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / ( float )( textures[ texture_id ].width ) * ( sprite->src.x + sprite->src.w );  // Right X
+        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = left; // Left X
+        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = right;  // Right X
     }
     else
     {
-        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / ( float )( textures[ texture_id ].width ) * sprite->src.x; // Left X
-        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].width ) * ( sprite->src.x + sprite->src.w );  // Right X
+        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = left; // Left X
+        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = right;  // Right X
     }
 
     if ( sprite->flip_y )
     {
-        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].height ) * ( sprite->src.y + sprite->src.h ); // Top Y
-        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / ( float )( textures[ texture_id ].height ) * sprite->src.y;  // Bottom Y
+        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = bottom; // Top Y
+        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = top;  // Bottom Y
     }
     else
     {
-        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / ( float )( textures[ texture_id ].height ) * ( sprite->src.y + sprite->src.h ); // Top Y
-        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].height ) * sprite->src.y;  // Bottom Y
+        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = bottom; // Top Y
+        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = top;  // Bottom Y
     }
     BufferVertices( vptr );
 };
@@ -6988,16 +11712,17 @@ static void UpdateSpriteX( unsigned int id )
     BindBuffers( id );
     float * vptr = GetVertices( id );
     const NasrGraphicSprite * sprite = &graphics[ gfx_ptrs_id_to_pos[ id ] ].data.sprite;
-    const unsigned int texture_id = sprite->texture;
+    float left, right, top, bottom;
+    GetSpriteTextureCoords( sprite, &left, &right, &top, &bottom );
     if ( sprite->flip_x )
     {
-        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].width ) * sprite->src.x; // Left X
-        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / ( float )( textures[ texture_id ].width ) * ( sprite->src.x + sprite->src.w );  // Right X
+        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = left; // Left X
+        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = right;  // Right X
     }
     else
     {
-        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = 1.0f / ( float )( textures[ texture_id ].width ) * sprite->src.x; // Left X
-        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].width ) * ( sprite->src.x + sprite->src.w );  // Right X
+        vptr[ 2 + VERTEX_SIZE * 3 ] = vptr[ 2 + VERTEX_SIZE * 2 ] = left; // Left X
+        vptr[ 2 ] = vptr[ 2 + VERTEX_SIZE ] = right;  // Right X
     }
     BufferVertices( vptr );
     ClearBufferBindings();
@@ -7008,17 +11733,140 @@ static void UpdateSpriteY( unsigned int id )
     BindBuffers( id );
     float * vptr = GetVertices( id );
     const NasrGraphicSprite * sprite = &graphics[ gfx_ptrs_id_to_pos[ id ] ].data.sprite;
-    const unsigned int texture_id = sprite->texture;
+    float left, right, top, bottom;
+    GetSpriteTextureCoords( sprite, &left, &right, &top, &bottom );
     if ( sprite->flip_y )
     {
-        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].height ) * ( sprite->src.y + sprite->src.h ); // Top Y
-        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / ( float )( textures[ texture_id ].height ) * sprite->src.y;  // Bottom Y
+        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = bottom; // Top Y
+        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = top;  // Bottom Y
     }
     else
     {
-        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = 1.0f / ( float )( textures[ texture_id ].height ) * ( sprite->src.y + sprite->src.h ); // Top Y
-        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = 1.0f / ( float )( textures[ texture_id ].height ) * sprite->src.y;  // Bottom Y
+        vptr[ 3 + VERTEX_SIZE * 3 ] = vptr[ 3 ] = bottom; // Top Y
+        vptr[ 3 + VERTEX_SIZE * 2 ] = vptr[ 3 + VERTEX_SIZE ] = top;  // Bottom Y
     }
     BufferVertices( vptr );
     ClearBufferBindings();
+};
+
+static void UpdateTextureMipmaps( unsigned int texture )
+{
+    if ( textures[ texture ].layered )
+    {
+        const TextureArray * array = &texture_arrays[ textures[ texture ].array ];
+        if ( TextureMipmapped( array->sampling, array->indexed ) )
+        {
+            glBindTexture( GL_TEXTURE_2D_ARRAY, array->id );
+            glGenerateMipmap( GL_TEXTURE_2D_ARRAY );
+            ResetTextureBindings();
+        }
+        return;
+    }
+    if ( !textures[ texture ].mipmapped )
+    {
+        return;
+    }
+    glBindTexture( GL_TEXTURE_2D, texture_ids[ texture ] );
+    glGenerateMipmap( GL_TEXTURE_2D );
+    ResetTextureBindings();
+};
+
+static int UpdateTileAnimationTable( TileAnimationTable * table )
+{
+    // Work out current tile for every animation so shader needs just 1 lookup; entry 0 is unused since 0 means no animation.
+    uint_fast8_t changed = 0;
+    for ( unsigned int i = 0; i < table->count; ++i )
+    {
+        const NasrTileAnimation * a = &table->list[ i ];
+        const unsigned int frame = a->count ? ( animation_clock / NASR_MATH_MAX( a->speed, 1 ) ) % a->count : 0;
+        unsigned char * texel = &table->frames[ ( i + 1 ) * 4 ];
+        if ( texel[ 0 ] != a->frames[ frame ].x || texel[ 1 ] != a->frames[ frame ].y )
+        {
+            texel[ 0 ] = a->frames[ frame ].x;
+            texel[ 1 ] = a->frames[ frame ].y;
+            changed = 1;
+        }
+    }
+    if ( changed )
+    {
+        glBindTexture( GL_TEXTURE_2D, table->texture );
+        glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, table->frames );
+    }
+    return changed;
+};
+
+static void UpdateTilemapSolidity( NasrGraphicTilemap * tilemap, int x, int y, int w, int h )
+{
+    // Any tile that isn’t cleared counts as solid.
+    const unsigned int width = textures[ tilemap->tilemap ].width;
+    for ( int row = y; row < y + h; ++row )
+    {
+        uint64_t * bits = &tilemap->solid[ ( size_t )( row ) * tilemap->solid_stride ];
+        for ( int col = x; col < x + w; ++col )
+        {
+            const uint64_t mask = ( uint64_t )( 1 ) << ( col % 64 );
+            const int solid = tilemap->data[ ( ( size_t )( row ) * width + col ) * 4 + 3 ] != 255;
+            const int was_solid = ( bits[ col / 64 ] & mask ) != 0;
+            if ( solid != was_solid )
+            {
+                bits[ col / 64 ] ^= mask;
+                if ( solid )
+                {
+                    ++tilemap->solid_rows[ row ];
+                }
+                else
+                {
+                    --tilemap->solid_rows[ row ];
+                }
+            }
+        }
+    }
+};
+
+static void UploadTextStreamLine( NasrGraphicTextStream * stream, unsigned int line_id, unsigned int slot )
+{
+    const TextStreamLine * line = &stream->lines[ line_id ];
+    const Texture * texture = &charmaps.list[ stream->charset ].texture;
+    float x = line->x;
+    unsigned int n = 0;
+    for ( unsigned int i = line->start; i < line->end; )
+    {
+        int len;
+        const CharTemplate * c = FindCharTemplate( stream->charset, &stream->string[ i ], &len );
+        i += len;
+        if ( !c )
+        {
+            continue;
+        }
+
+        if ( c->chartype != NASR_CHAR_WHITESPACE )
+        {
+            float * vptr = &stream->vertices[ n * VERTEX_RECT_SIZE ];
+            const float y = line->y + ( ( line->height - c->src.h ) / 2.0f );
+            ResetVertices( vptr );
+            vptr[ 0 ] = vptr[ VERTEX_SIZE ] = x + c->src.w; // Right X
+            vptr[ VERTEX_SIZE * 2 ] = vptr[ VERTEX_SIZE * 3 ] = x; // Left X
+            vptr[ 1 ] = vptr[ 1 + VERTEX_SIZE * 3 ] = y + c->src.h; // Bottom Y
+            vptr[ 1 + VERTEX_SIZE ] = vptr[ 1 + VERTEX_SIZE * 2 ] = y; // Top Y
+            UpdateCharVertices( vptr, &c->src, texture );
+            FillVerticesColorValues( vptr, &stream->color, &stream->color, &stream->color, &stream->color );
+            ++n;
+        }
+        if ( c->src.w > 0.0f )
+        {
+            x += c->src.w + line->letterspace;
+        }
+    }
+
+    if ( n )
+    {
+        glBufferSubData
+        (
+            GL_ARRAY_BUFFER,
+            slot * stream->max_line_glyphs * VERTEX_RECT_SIZE * sizeof( float ),
+            n * VERTEX_RECT_SIZE * sizeof( float ),
+            stream->vertices
+        );
+    }
+    stream->slot_lines[ slot ] = ( int )( line_id );
 };
\ No newline at end of file
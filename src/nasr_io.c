@@ -2,6 +2,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 char * NasrReadFile( const char * filename )
 {
     // Open file.
@@ -40,4 +47,61 @@ char * NasrReadFile( const char * filename )
 
     fclose( file );
     return buffer;
+};
+
+void * NasrMapFile( const char * filename, size_t * size )
+{
+    #ifdef _WIN32
+        // No mmap here, so just read whole file into memory.
+        FILE * file = fopen( filename, "rb" );
+        if ( file == NULL )
+        {
+            return 0;
+        }
+        fseek( file, 0L, SEEK_END );
+        const long length = ftell( file );
+        rewind( file );
+        void * buffer = length > 0 ? malloc( length ) : 0;
+        if ( buffer == NULL || fread( buffer, 1, length, file ) < ( size_t )( length ) )
+        {
+            free( buffer );
+            fclose( file );
+            return 0;
+        }
+        fclose( file );
+        *size = ( size_t )( length );
+        return buffer;
+    #else
+        const int file = open( filename, O_RDONLY );
+        if ( file < 0 )
+        {
+            return 0;
+        }
+
+        struct stat info;
+        if ( fstat( file, &info ) != 0 || info.st_size <= 0 )
+        {
+            close( file );
+            return 0;
+        }
+
+        // Mapping stays valid after file is closed.
+        void * data = mmap( 0, info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+        close( file );
+        if ( data == MAP_FAILED )
+        {
+            return 0;
+        }
+        *size = ( size_t )( info.st_size );
+        return data;
+    #endif
+};
+
+void NasrUnmapFile( void * data, size_t size )
+{
+    #ifdef _WIN32
+        free( data );
+    #else
+        munmap( data, size );
+    #endif
 };
\ No newline at end of file
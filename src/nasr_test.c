@@ -44,6 +44,7 @@ void NasrTestRun( void )
     NasrSetPalette( "assets/palette2.png" );
     const int charset1 = NasrAddCharset( "assets/latin1.png", "assets/latin1.json" );
     const int charset2 = NasrAddCharset( "assets/latin2.png", "assets/latin2.json" );
+    NasrPackCharsets();
     NasrSetLanguage( "assets/es.json", "nasringine" );
     
     NasrInput inputs[] =